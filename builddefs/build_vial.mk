@@ -8,7 +8,8 @@ ifeq ($(strip $(TAP_DANCE_ENABLE)), yes)
 endif
 COMBO_ENABLE ?= yes
 KEY_OVERRIDE_ENABLE ?= yes
-SRC += $(QUANTUM_DIR)/vial.c
+SRC += $(QUANTUM_DIR)/vial.c \
+       $(QUANTUM_DIR)/vial_bulk.c
 OPT_DEFS += -DVIAL_ENABLE -DNO_DEBUG -DSERIAL_NUMBER=\"vial:f64c2b3c\"
 
 ifeq ($(strip $(VIAL_INSECURE)), yes)
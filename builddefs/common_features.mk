@@ -660,6 +660,9 @@ endif
 
 
 VALID_SERIAL_DRIVER_TYPES := bitbang usart vendor
+ifeq ($(strip $(PLATFORM)), TEST)
+    VALID_SERIAL_DRIVER_TYPES += loopback
+endif
 
 SERIAL_DRIVER ?= bitbang
 ifeq ($(filter $(SERIAL_DRIVER),$(VALID_SERIAL_DRIVER_TYPES)),)
@@ -681,6 +684,15 @@ ifeq ($(strip $(SPLIT_KEYBOARD)), yes)
 
         OPT_DEFS += -DSPLIT_COMMON_TRANSACTIONS
 
+        ifeq ($(strip $(SPLIT_TELEMETRY_ENABLE)), yes)
+            OPT_DEFS += -DSPLIT_TELEMETRY_ENABLE
+            QUANTUM_SRC += $(QUANTUM_DIR)/split_common/split_telemetry.c
+            # Round trips are timed with the scan profiler's clock
+            ifneq ($(strip $(SCAN_PROFILE_ENABLE)), yes)
+                QUANTUM_SRC += $(QUANTUM_DIR)/scan_profile.c
+            endif
+        endif
+
         # Functions added via QUANTUM_LIB_SRC are only included in the final binary if they're called.
         # Unused functions are pruned away, which is why we can add multiple drivers here without bloat.
         ifeq ($(PLATFORM),AVR)
@@ -693,6 +705,10 @@ ifeq ($(strip $(SPLIT_KEYBOARD)), yes)
         OPT_DEFS += -DSERIAL_DRIVER_$(strip $(shell echo $(SERIAL_DRIVER) | tr '[:lower:]' '[:upper:]'))
         ifeq ($(strip $(SERIAL_DRIVER)), bitbang)
             QUANTUM_LIB_SRC += serial.c
+        else ifeq ($(strip $(SERIAL_DRIVER)), loopback)
+            # Both halves in one process, for the test platform
+            QUANTUM_SRC += $(PLATFORM_PATH)/$(PLATFORM_KEY)/$(DRIVER_DIR)/serial_loopback.c \
+                           $(PLATFORM_PATH)/$(PLATFORM_KEY)/$(DRIVER_DIR)/serial_loopback_slave.c
         else
             QUANTUM_LIB_SRC += serial_protocol.c
             QUANTUM_LIB_SRC += serial_$(strip $(SERIAL_DRIVER)).c
@@ -921,7 +937,7 @@ ifeq ($(strip $(WS2812_DRIVER_REQUIRED)), yes)
 
     OPT_DEFS += -DWS2812_$(strip $(shell echo $(WS2812_DRIVER) | tr '[:lower:]' '[:upper:]'))
 
-    SRC += ws2812_$(strip $(WS2812_DRIVER)).c
+    SRC += ws2812.c ws2812_$(strip $(WS2812_DRIVER)).c
 
     ifeq ($(strip $(PLATFORM)), CHIBIOS)
         ifeq ($(strip $(WS2812_DRIVER)), pwm)
@@ -33,6 +33,7 @@ GENERIC_FEATURES = \
     DYNAMIC_TAPPING_TERM \
     GRAVE_ESC \
     HAPTIC \
+    IDLE_SCHEDULER \
     KEY_LOCK \
     KEY_OVERRIDE \
     LEADER \
@@ -42,6 +43,7 @@ GENERIC_FEATURES = \
     OS_DETECTION \
     PROGRAMMABLE_BUTTON \
     REPEAT_KEY \
+    SCAN_PROFILE \
     SECURE \
     SEND_STRING \
     SEQUENCER \
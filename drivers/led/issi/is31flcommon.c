@@ -30,6 +30,11 @@
 #ifndef ISSI_PERSISTENCE
 #    define ISSI_PERSISTENCE 0
 #endif
+// Clean registers between two changed ones that are still sent as part of the same transfer,
+// rather than paying for another start, device address, register address and stop
+#ifndef ISSI_PWM_SPAN_GAP
+#    define ISSI_PWM_SPAN_GAP 3
+#endif
 
 // Transfer buffer for TWITransmitData()
 uint8_t g_twi_transfer_buffer[20];
@@ -38,6 +43,8 @@ uint8_t g_twi_transfer_buffer[20];
 // Storing them like this is optimal for I2C transfers to the registers.
 uint8_t g_pwm_buffer[DRIVER_COUNT][ISSI_MAX_LEDS];
 bool    g_pwm_buffer_update_required[DRIVER_COUNT] = {false};
+// One bit per PWM register that changed since the last flush
+uint8_t g_pwm_buffer_dirty[DRIVER_COUNT][(ISSI_MAX_LEDS + 7) / 8];
 
 uint8_t g_scaling_buffer[DRIVER_COUNT][ISSI_SCALING_SIZE];
 bool    g_scaling_buffer_update_required[DRIVER_COUNT] = {false};
@@ -120,12 +127,56 @@ void IS31FL_common_init(uint8_t addr, uint8_t ssr) {
     wait_ms(10);
 }
 
+static inline bool IS31FL_pwm_register_dirty(uint8_t index, uint8_t reg) {
+    return g_pwm_buffer_dirty[index][reg / 8] & (1 << (reg % 8));
+}
+
+static void IS31FL_set_pwm_register(uint8_t index, uint8_t reg, uint8_t value) {
+    if (g_pwm_buffer[index][reg] != value) {
+        g_pwm_buffer[index][reg] = value;
+        g_pwm_buffer_dirty[index][reg / 8] |= 1 << (reg % 8);
+        g_pwm_buffer_update_required[index] = true;
+    }
+}
+
+// The drivers may still hold the PWM values from before a soft reset, so the first flush sends everything
+static void IS31FL_invalidate_pwm_buffers(void) {
+    memset(g_pwm_buffer_dirty, 0xFF, sizeof(g_pwm_buffer_dirty));
+    for (uint8_t i = 0; i < DRIVER_COUNT; i++) {
+        g_pwm_buffer_update_required[i] = true;
+    }
+}
+
 void IS31FL_common_update_pwm_register(uint8_t addr, uint8_t index) {
     if (g_pwm_buffer_update_required[index]) {
         // Queue up the correct page
         IS31FL_unlock_register(addr, ISSI_PAGE_PWM);
-        // Hand off the update to IS31FL_write_multi_registers
-        IS31FL_write_multi_registers(addr, g_pwm_buffer[index], ISSI_MAX_LEDS, ISSI_PWM_TRF_SIZE, ISSI_PWM_REG_1ST);
+        // Only send the spans of registers that changed, each at most ISSI_PWM_TRF_SIZE long
+        uint8_t reg = 0;
+        while (reg < ISSI_MAX_LEDS) {
+            if (reg % 8 == 0 && g_pwm_buffer_dirty[index][reg / 8] == 0) {
+                reg += 8;
+                continue;
+            }
+            if (!IS31FL_pwm_register_dirty(index, reg)) {
+                reg++;
+                continue;
+            }
+            uint8_t start = reg;
+            uint8_t end   = reg + 1;
+            for (reg++; reg < ISSI_MAX_LEDS && reg - start < ISSI_PWM_TRF_SIZE && reg - end <= ISSI_PWM_SPAN_GAP; reg++) {
+                if (IS31FL_pwm_register_dirty(index, reg)) {
+                    end = reg + 1;
+                }
+            }
+            // Hand off the span to IS31FL_write_multi_registers, leaving it dirty to be retried on the next flush if it fails
+            if (!IS31FL_write_multi_registers(addr, g_pwm_buffer[index] + start, end - start, end - start, ISSI_PWM_REG_1ST + start)) {
+                return;
+            }
+            for (reg = start; reg < end; reg++) {
+                g_pwm_buffer_dirty[index][reg / 8] &= ~(1 << (reg % 8));
+            }
+        }
         // Update flags that pwm_buffer has been updated
         g_pwm_buffer_update_required[index] = false;
     }
@@ -201,6 +252,7 @@ void IS31FL_RGB_init_drivers(void) {
 #            endif
 #        endif
 #    endif
+    IS31FL_invalidate_pwm_buffers();
 
     for (int i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
         IS31FL_RGB_set_scaling_buffer(i, true, true, true);
@@ -229,10 +281,9 @@ void IS31FL_RGB_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
         is31_led led;
         memcpy_P(&led, (&g_is31_leds[index]), sizeof(led));
 
-        g_pwm_buffer[led.driver][led.r]          = red;
-        g_pwm_buffer[led.driver][led.g]          = green;
-        g_pwm_buffer[led.driver][led.b]          = blue;
-        g_pwm_buffer_update_required[led.driver] = true;
+        IS31FL_set_pwm_register(led.driver, led.r, red);
+        IS31FL_set_pwm_register(led.driver, led.g, green);
+        IS31FL_set_pwm_register(led.driver, led.b, blue);
     }
 }
 
@@ -279,6 +330,7 @@ void IS31FL_simple_init_drivers(void) {
 #            endif
 #        endif
 #    endif
+    IS31FL_invalidate_pwm_buffers();
 
     for (int i = 0; i < LED_MATRIX_LED_COUNT; i++) {
         IS31FL_simple_set_scaling_buffer(i, true);
@@ -317,8 +369,7 @@ void IS31FL_simple_set_brightness(int index, uint8_t value) {
         is31_led led;
         memcpy_P(&led, (&g_is31_leds[index]), sizeof(led));
 
-        g_pwm_buffer[led.driver][led.v] = value;
-        g_pwm_buffer_update_required[led.driver] = true;
+        IS31FL_set_pwm_register(led.driver, led.v, value);
     }
 }
 
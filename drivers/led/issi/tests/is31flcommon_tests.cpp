@@ -0,0 +1,111 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "is31flcommon.h"
+#include "i2c_master.h"
+
+extern uint8_t g_pwm_buffer[DRIVER_COUNT][ISSI_MAX_LEDS];
+
+// LED n uses the three consecutive PWM registers starting at 3n, filling the whole page
+#define LED(n) \
+    { 0, 3 * (n), 3 * (n) + 1, 3 * (n) + 2 }
+#define LED_ROW(n) LED(n), LED(n + 1), LED(n + 2), LED(n + 3), LED(n + 4), LED(n + 5)
+
+const is31_led PROGMEM g_is31_leds[RGB_MATRIX_LED_COUNT] = {
+    LED_ROW(0), LED_ROW(6), LED_ROW(12), LED_ROW(18), LED_ROW(24), LED_ROW(30), LED_ROW(36), LED_ROW(42), LED_ROW(48), LED_ROW(54), LED_ROW(60),
+};
+}
+
+// Page unlock, two single register writes
+#define UNLOCK_TRANSMISSIONS 2
+#define UNLOCK_BYTES 4
+#define FULL_FRAME_TRANSMISSIONS (UNLOCK_TRANSMISSIONS + (ISSI_MAX_LEDS + ISSI_PWM_TRF_SIZE - 1) / ISSI_PWM_TRF_SIZE)
+#define FULL_FRAME_BYTES (UNLOCK_BYTES + ISSI_MAX_LEDS + (ISSI_MAX_LEDS + ISSI_PWM_TRF_SIZE - 1) / ISSI_PWM_TRF_SIZE)
+
+class IS31FLCommon : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        IS31FL_RGB_init_drivers();
+        IS31FL_RGB_set_color_all(0, 0, 0);
+        IS31FL_common_flush();
+        i2c_mock_reset();
+    }
+
+    void flush_and_check() {
+        IS31FL_common_flush();
+        const uint8_t* registers = i2c_mock_registers(DRIVER_ADDR_1 << 1);
+        for (int i = 0; i < ISSI_MAX_LEDS; i++) {
+            ASSERT_EQ(registers[ISSI_PWM_REG_1ST + i], g_pwm_buffer[0][i]) << "PWM register " << i;
+        }
+    }
+};
+
+TEST_F(IS31FLCommon, FirstFlushSendsWholeFrame) {
+    IS31FL_RGB_init_drivers();
+    i2c_mock_reset();
+    flush_and_check();
+    EXPECT_EQ(i2c_mock_transmissions(), FULL_FRAME_TRANSMISSIONS);
+    EXPECT_EQ(i2c_mock_bytes_transmitted(), FULL_FRAME_BYTES);
+}
+
+TEST_F(IS31FLCommon, UnchangedFrameSendsNothing) {
+    IS31FL_RGB_set_color(5, 0, 0, 0);
+    flush_and_check();
+    EXPECT_EQ(i2c_mock_transmissions(), 0);
+    EXPECT_EQ(i2c_mock_bytes_transmitted(), 0);
+}
+
+TEST_F(IS31FLCommon, SingleLedSendsOneSpan) {
+    IS31FL_RGB_set_color(10, 1, 2, 3);
+    flush_and_check();
+    EXPECT_EQ(i2c_mock_transmissions(), UNLOCK_TRANSMISSIONS + 1);
+    EXPECT_EQ(i2c_mock_bytes_transmitted(), UNLOCK_BYTES + 1 + 3);
+
+    // Only the channel that changed
+    i2c_mock_reset();
+    IS31FL_RGB_set_color(10, 1, 5, 3);
+    flush_and_check();
+    EXPECT_EQ(i2c_mock_transmissions(), UNLOCK_TRANSMISSIONS + 1);
+    EXPECT_EQ(i2c_mock_bytes_transmitted(), UNLOCK_BYTES + 1 + 1);
+}
+
+TEST_F(IS31FLCommon, NearbyLedsShareASpan) {
+    // Registers 0-2 and 6-8, the three in between are sent along rather than starting another transfer
+    IS31FL_RGB_set_color(0, 1, 1, 1);
+    IS31FL_RGB_set_color(2, 1, 1, 1);
+    flush_and_check();
+    EXPECT_EQ(i2c_mock_transmissions(), UNLOCK_TRANSMISSIONS + 1);
+    EXPECT_EQ(i2c_mock_bytes_transmitted(), UNLOCK_BYTES + 1 + 9);
+
+    // Registers 0-2 and 9-11 are too far apart
+    i2c_mock_reset();
+    IS31FL_RGB_set_color(0, 2, 2, 2);
+    IS31FL_RGB_set_color(3, 2, 2, 2);
+    flush_and_check();
+    EXPECT_EQ(i2c_mock_transmissions(), UNLOCK_TRANSMISSIONS + 2);
+    EXPECT_EQ(i2c_mock_bytes_transmitted(), UNLOCK_BYTES + 2 * (1 + 3));
+}
+
+TEST_F(IS31FLCommon, SpansAreSplitAtTransferSize) {
+    IS31FL_RGB_set_color_all(7, 7, 7);
+    flush_and_check();
+    EXPECT_EQ(i2c_mock_transmissions(), FULL_FRAME_TRANSMISSIONS);
+    EXPECT_EQ(i2c_mock_bytes_transmitted(), FULL_FRAME_BYTES);
+}
+
+TEST_F(IS31FLCommon, ReactiveFrameBytes) {
+    // A reactive effect fading out a handful of keys
+    const int keys[] = {3, 17, 18, 40, 61};
+    for (uint8_t value = 255; value > 0; value -= 51) {
+        for (int key : keys) {
+            IS31FL_RGB_set_color(key, value, value / 2, 0);
+        }
+        i2c_mock_reset();
+        flush_and_check();
+        std::cout << "[ I2C      ] reactive frame: " << i2c_mock_bytes_transmitted() << " bytes in " << i2c_mock_transmissions() << " transmissions, full frame: " << FULL_FRAME_BYTES << " bytes" << std::endl;
+        EXPECT_LT(i2c_mock_bytes_transmitted(), FULL_FRAME_BYTES / 4);
+    }
+}
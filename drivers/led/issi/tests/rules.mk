@@ -0,0 +1,11 @@
+is31flcommon_DEFS := -DRGB_MATRIX_ENABLE -DRGB_MATRIX_IS31FL3743A -DRGB_MATRIX_LED_COUNT=66 -DDRIVER_ADDR_1=0x20
+
+is31flcommon_INC := \
+	$(DRIVER_PATH)/led/issi \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/drivers
+
+is31flcommon_SRC := \
+	$(DRIVER_PATH)/led/issi/tests/is31flcommon_tests.cpp \
+	$(DRIVER_PATH)/led/issi/is31flcommon.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/drivers/i2c_master.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
@@ -973,6 +973,40 @@ void oled_task(void) {
 #endif
 }
 
+static void oled_update_deadline(uint32_t *deadline, uint32_t left) {
+    if (left < *deadline) {
+        *deadline = left;
+    }
+}
+
+uint32_t oled_next_deadline(void) {
+    uint32_t deadline = UINT32_MAX;
+    if (!oled_initialized) {
+        return deadline;
+    }
+
+#if OLED_UPDATE_INTERVAL > 0
+    uint16_t elapsed = timer_elapsed(oled_update_timeout);
+    oled_update_deadline(&deadline, elapsed < OLED_UPDATE_INTERVAL ? OLED_UPDATE_INTERVAL - elapsed : 0);
+#endif
+
+#if OLED_TIMEOUT > 0
+    if (oled_active) {
+        uint32_t now = timer_read32();
+        oled_update_deadline(&deadline, timer_expired32(now, oled_timeout) ? 0 : oled_timeout - now);
+    }
+#endif
+
+#if OLED_SCROLL_TIMEOUT > 0
+    if (!oled_scrolling) {
+        uint32_t now = timer_read32();
+        oled_update_deadline(&deadline, timer_expired32(now, oled_scroll_timeout) ? 0 : oled_scroll_timeout - now);
+    }
+#endif
+
+    return deadline;
+}
+
 __attribute__((weak)) bool oled_task_kb(void) {
     return oled_task_user();
 }
@@ -446,6 +446,9 @@ uint8_t oled_get_brightness(void);
 // Basically it's oled_render, but with timeout management and oled_task_user calling!
 void oled_task(void);
 
+// Milliseconds until oled_task has timed work to do (update interval, timeouts), UINT32_MAX if none
+uint32_t oled_next_deadline(void);
+
 // Called at the start of oled_task, weak function overridable by the user
 bool oled_task_kb(void);
 bool oled_task_user(void);
@@ -0,0 +1,12 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "ws2812.h"
+
+// For drivers that cannot send in the background
+__attribute__((weak)) void ws2812_setleds_async(rgb_led_t *ledarray, uint16_t number_of_leds, void (*done)(void)) {
+    ws2812_setleds(ledarray, number_of_leds);
+    if (done) {
+        done();
+    }
+}
@@ -74,3 +74,10 @@
  *         - Wait 50us to reset the LEDs
  */
 void ws2812_setleds(rgb_led_t *ledarray, uint16_t number_of_leds);
+
+/* Same as ws2812_setleds(), but returns as soon as ledarray has been copied to the driver's own buffer,
+ * leaving the transfer to run in the background. `done` (may be NULL) is called once the LEDs have been
+ * sent, possibly from an interrupt. Drivers that cannot send in the background send synchronously and
+ * call `done` before returning.
+ */
+void ws2812_setleds_async(rgb_led_t *ledarray, uint16_t number_of_leds, void (*done)(void));
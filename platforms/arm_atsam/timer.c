@@ -22,6 +22,10 @@ uint64_t timer_read64(void) {
     return ms_clk;
 }
 
+uint32_t timer_read_us(void) {
+    return (uint32_t)(ms_clk * 1000);
+}
+
 uint16_t timer_elapsed(uint16_t tlast) {
     return TIMER_DIFF_16(timer_read(), tlast);
 }
@@ -424,8 +424,14 @@ ISR(SERIAL_PIN_INTERRUPT) {
     change_sender2reciver();
 
     // target recive phase
+    // the header says how much of the buffer follows, there is a sync's worth of time to work it out before the next byte
     if (trans->initiator2target_buffer_size > 0) {
-        serial_recive_packet((uint8_t *)split_trans_initiator2target_buffer(trans), trans->initiator2target_buffer_size);
+        uint8_t header = split_trans_initiator2target_header(tid, trans);
+        serial_recive_packet((uint8_t *)split_trans_initiator2target_buffer(trans), header);
+        uint8_t length = split_trans_initiator2target_length(tid, trans, split_trans_initiator2target_buffer(trans));
+        if (length > header) {
+            serial_recive_packet((uint8_t *)split_trans_initiator2target_buffer(trans) + header, length - header);
+        }
     }
 
     sync_recv(); // weit initiator output to high
@@ -489,7 +495,7 @@ bool soft_serial_transaction(int sstd_index) {
 
     // initiator send phase
     if (trans->initiator2target_buffer_size > 0) {
-        serial_send_packet((uint8_t *)split_trans_initiator2target_buffer(trans), trans->initiator2target_buffer_size);
+        serial_send_packet((uint8_t *)split_trans_initiator2target_buffer(trans), split_trans_initiator2target_length(sstd_index, trans, split_trans_initiator2target_buffer(trans)));
     }
 
     // always, release the line when not in use
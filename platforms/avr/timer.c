@@ -106,6 +106,29 @@ inline uint32_t timer_read32(void) {
     return t;
 }
 
+/** \brief timer read microseconds
+ *
+ * Combines the millisecond count with the Timer0 counter, so the resolution is one Timer0 tick
+ */
+uint32_t timer_read_us(void) {
+    uint32_t t;
+    uint8_t  raw;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        t   = timer_count;
+        raw = TIMER_RAW;
+#if defined(TIFR0) && defined(OCF0A)
+        // Timer0 already wrapped, but its interrupt has not run yet
+        if (TIFR0 & _BV(OCF0A)) {
+            t++;
+            raw = TIMER_RAW;
+        }
+#endif
+    }
+
+    return t * 1000 + (uint32_t)raw * 1000 / (TIMER_RAW_TOP + 1);
+}
+
 /** \brief timer elapsed
  *
  * FIXME: needs doc
@@ -167,9 +167,15 @@ void interrupt_handler(void *arg) {
     sstd_index = serial_read_byte();
     sync_send();
 
-    split_transaction_desc_t *trans = &split_transaction_table[sstd_index];
-    for (int i = 0; i < trans->initiator2target_buffer_size; ++i) {
+    split_transaction_desc_t *trans  = &split_transaction_table[sstd_index];
+    uint8_t                   header = split_trans_initiator2target_header(sstd_index, trans);
+    uint8_t                   length = header;
+    for (int i = 0; i < length; ++i) {
         split_trans_initiator2target_buffer(trans)[i] = serial_read_byte();
+        // once the header is in it says how much more the master sends, worked out before the sync so the master waits for it
+        if (i + 1 == header) {
+            length = split_trans_initiator2target_length(sstd_index, trans, split_trans_initiator2target_buffer(trans));
+        }
         sync_send();
         checksum_computed += split_trans_initiator2target_buffer(trans)[i];
     }
@@ -245,7 +251,8 @@ static inline bool initiate_transaction(uint8_t sstd_index) {
     serial_write_byte(sstd_index); // first chunk is transaction id
     sync_recv();
 
-    for (int i = 0; i < trans->initiator2target_buffer_size; ++i) {
+    uint8_t length = split_trans_initiator2target_length(sstd_index, trans, split_trans_initiator2target_buffer(trans));
+    for (int i = 0; i < length; ++i) {
         serial_write_byte(split_trans_initiator2target_buffer(trans)[i]);
         sync_recv();
         checksum += split_trans_initiator2target_buffer(trans)[i];
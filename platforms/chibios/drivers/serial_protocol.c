@@ -66,14 +66,23 @@ static inline bool react_to_transaction(void) {
 
     /* Send back the handshake which is XORed as a simple checksum,
      to signal that the slave is ready to receive possible transaction buffers  */
-    transaction_id ^= NUM_TOTAL_TRANSACTIONS;
-    if (unlikely(!serial_transport_send(&transaction_id, sizeof(transaction_id)))) {
+    uint8_t transaction_id_shake = transaction_id ^ NUM_TOTAL_TRANSACTIONS;
+    if (unlikely(!serial_transport_send(&transaction_id_shake, sizeof(transaction_id_shake)))) {
         return false;
     }
 
-    /* Receive transaction buffer from the master. If this transaction requires it.*/
+    /* Receive transaction buffer from the master. If this transaction requires it.
+     * Its header says how much of the buffer the master sends. */
     if (transaction->initiator2target_buffer_size) {
-        if (unlikely(!serial_transport_receive(split_trans_initiator2target_buffer(transaction), transaction->initiator2target_buffer_size))) {
+        uint8_t header = split_trans_initiator2target_header(transaction_id, transaction);
+        if (unlikely(!serial_transport_receive(split_trans_initiator2target_buffer(transaction), header))) {
+            return false;
+        }
+        uint8_t length = split_trans_initiator2target_length(transaction_id, transaction, split_trans_initiator2target_buffer(transaction));
+        if (unlikely(length < header)) {
+            return false;
+        }
+        if (length > header && unlikely(!serial_transport_receive(split_trans_initiator2target_buffer(transaction) + header, length - header))) {
             return false;
         }
     }
@@ -140,7 +149,7 @@ static inline bool initiate_transaction(uint8_t transaction_id) {
 
     /* Send transaction buffer to the slave. If this transaction requires it. */
     if (transaction->initiator2target_buffer_size) {
-        if (unlikely(!serial_transport_send(split_trans_initiator2target_buffer(transaction), transaction->initiator2target_buffer_size))) {
+        if (unlikely(!serial_transport_send(split_trans_initiator2target_buffer(transaction), split_trans_initiator2target_length(transaction_id, transaction, split_trans_initiator2target_buffer(transaction))))) {
             serial_dprintf("SPLIT: sending buffer failed\n");
             return false;
         }
@@ -88,6 +88,23 @@
 
 static uint8_t txbuf[PREAMBLE_SIZE + DATA_SIZE + RESET_SIZE] = {0};
 
+// Without the circular buffer or WS2812_SPI_SYNC, frames are sent in the background from txbuf
+#if !defined(WS2812_SPI_USE_CIRCULAR_BUFFER) && !defined(WS2812_SPI_SYNC)
+#    define WS2812_SPI_BACKGROUND
+static volatile bool ws2812_spi_busy = false;
+static void (*ws2812_spi_done)(void);
+
+static void ws2812_spi_end_cb(SPIDriver* spip) {
+    ws2812_spi_busy = false;
+    if (ws2812_spi_done) {
+        ws2812_spi_done();
+    }
+}
+#    define WS2812_SPI_END_CB ws2812_spi_end_cb
+#else
+#    define WS2812_SPI_END_CB NULL
+#endif
+
 /*
  * As the trick here is to use the SPI to send a huge pattern of 0 and 1 to
  * the ws2812b protocol, we use this helper function to translate bytes into
@@ -151,7 +168,7 @@ void ws2812_init(void) {
 #    if SPI_SUPPORTS_CIRCULAR == TRUE
         WS2812_SPI_BUFFER_MODE,
 #    endif
-        NULL, // end_cb
+        WS2812_SPI_END_CB, // end_cb
         PAL_PORT(WS2812_DI_PIN),
         PAL_PAD(WS2812_DI_PIN),
 #    if defined(WB32F3G71xx) || defined(WB32FQ95xx)
@@ -170,7 +187,7 @@ void ws2812_init(void) {
 #    if SPI_SUPPORTS_SLAVE_MODE == TRUE
         false,
 #    endif
-        NULL, // data_cb
+        WS2812_SPI_END_CB, // data_cb
         NULL, // error_cb
         PAL_PORT(WS2812_DI_PIN),
         PAL_PAD(WS2812_DI_PIN),
@@ -187,24 +204,37 @@ void ws2812_init(void) {
 #endif
 }
 
-void ws2812_setleds(rgb_led_t* ledarray, uint16_t leds) {
+void ws2812_setleds_async(rgb_led_t* ledarray, uint16_t leds, void (*done)(void)) {
     static bool s_init = false;
     if (!s_init) {
         ws2812_init();
         s_init = true;
     }
 
+#ifdef WS2812_SPI_BACKGROUND
+    // txbuf still holds the frame being sent
+    while (ws2812_spi_busy) {
+    }
+#endif
+
     for (uint8_t i = 0; i < leds; i++) {
         set_led_color_rgb(ledarray[i], i);
     }
 
-    // Send async - each led takes ~0.03ms, 50 leds ~1.5ms, animations flushing faster than send will cause issues.
-    // Instead spiSend can be used to send synchronously (or the thread logic can be added back).
-#ifndef WS2812_SPI_USE_CIRCULAR_BUFFER
-#    ifdef WS2812_SPI_SYNC
-    spiSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf), txbuf);
-#    else
+    // Send async unless configured otherwise - each led takes ~0.03ms, 50 leds ~1.5ms
+#ifdef WS2812_SPI_BACKGROUND
+    ws2812_spi_done = done;
+    ws2812_spi_busy = true;
     spiStartSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf), txbuf);
-#    endif
+    return;
+#elif !defined(WS2812_SPI_USE_CIRCULAR_BUFFER)
+    spiSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf), txbuf);
 #endif
+    if (done) {
+        done();
+    }
+}
+
+void ws2812_setleds(rgb_led_t* ledarray, uint16_t leds) {
+    ws2812_setleds_async(ledarray, leds, NULL);
 }
@@ -98,6 +98,21 @@ uint32_t timer_read32(void) {
     return (uint32_t)TIME_I2MS(ticks) + ms_offset_copy;
 }
 
+uint32_t timer_read_us(void) {
+#if (1000000 % CH_CFG_ST_FREQUENCY) == 0
+    chSysLock();
+    uint32_t ticks = get_system_time_ticks();
+    chSysUnlock();
+
+    // A whole number of microseconds per tick, so this wraps around cleanly along with the tick counter
+    return ticks * (1000000 / CH_CFG_ST_FREQUENCY);
+#else
+    // Converting ticks that are not a whole number of microseconds would need a 64-bit divide, so settle for
+    // millisecond resolution
+    return timer_read32() * 1000;
+#endif
+}
+
 uint16_t timer_elapsed(uint16_t last) {
     return TIMER_DIFF_16(timer_read(), last);
 }
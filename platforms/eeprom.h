@@ -60,8 +60,11 @@ void     eeprom_update_block(const void *__src, void *__dst, size_t __n);
 #    define TOTAL_EEPROM_BYTE_COUNT 4096
 #elif defined(EEPROM_TEST_HARNESS)
 #    ifndef LEGACY_FLASH_OPS_MOCKED
-// Normal tests
-#        define TOTAL_EEPROM_BYTE_COUNT 32
+// Normal tests, enough for all of EECONFIG_BASE_SIZE. Tests of the dynamic keymap need more.
+#        ifndef EEPROM_TEST_HARNESS_SIZE
+#            define EEPROM_TEST_HARNESS_SIZE 64
+#        endif
+#        define TOTAL_EEPROM_BYTE_COUNT EEPROM_TEST_HARNESS_SIZE
 #    else
 // Flash wear-leveling testing
 #        include "eeprom_legacy_emulated_flash_tests.h"
@@ -0,0 +1,84 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "i2c_master.h"
+#include <string.h>
+
+static uint8_t  registers[128][256];
+static uint32_t transmissions;
+static uint32_t bytes_transmitted;
+
+void i2c_init(void) {}
+
+i2c_status_t i2c_start(uint8_t address) {
+    return I2C_STATUS_SUCCESS;
+}
+
+i2c_status_t i2c_transmit(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    transmissions++;
+    bytes_transmitted += length;
+    if (length > 0) {
+        uint8_t* image = registers[address >> 1];
+        uint8_t  reg   = data[0];
+        for (uint16_t i = 1; i < length; i++) {
+            image[reg++] = data[i];
+        }
+    }
+    return I2C_STATUS_SUCCESS;
+}
+
+i2c_status_t i2c_receive(uint8_t address, uint8_t* data, uint16_t length, uint16_t timeout) {
+    transmissions++;
+    memset(data, 0, length);
+    return I2C_STATUS_SUCCESS;
+}
+
+i2c_status_t i2c_writeReg(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    transmissions++;
+    bytes_transmitted += length + 1;
+    for (uint16_t i = 0; i < length; i++) {
+        registers[devaddr >> 1][(uint8_t)(regaddr + i)] = data[i];
+    }
+    return I2C_STATUS_SUCCESS;
+}
+
+i2c_status_t i2c_writeReg16(uint8_t devaddr, uint16_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    transmissions++;
+    bytes_transmitted += length + 2;
+    return I2C_STATUS_SUCCESS;
+}
+
+i2c_status_t i2c_readReg(uint8_t devaddr, uint8_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout) {
+    transmissions++;
+    bytes_transmitted += 1;
+    for (uint16_t i = 0; i < length; i++) {
+        data[i] = registers[devaddr >> 1][(uint8_t)(regaddr + i)];
+    }
+    return I2C_STATUS_SUCCESS;
+}
+
+i2c_status_t i2c_readReg16(uint8_t devaddr, uint16_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout) {
+    transmissions++;
+    bytes_transmitted += 2;
+    memset(data, 0, length);
+    return I2C_STATUS_SUCCESS;
+}
+
+void i2c_stop(void) {}
+
+void i2c_mock_reset(void) {
+    transmissions     = 0;
+    bytes_transmitted = 0;
+}
+
+uint32_t i2c_mock_transmissions(void) {
+    return transmissions;
+}
+
+uint32_t i2c_mock_bytes_transmitted(void) {
+    return bytes_transmitted;
+}
+
+const uint8_t* i2c_mock_registers(uint8_t address) {
+    return registers[address >> 1];
+}
@@ -0,0 +1,39 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/* Mock of the i2c_master API for the test platform.
+ * Transmissions are not sent anywhere, they are counted and applied to a register image
+ * per device, assuming the usual "first byte selects the register, then auto-increment"
+ * protocol. As with the hardware drivers, addresses are expected to be already shifted.
+ */
+#pragma once
+
+#include <stdint.h>
+
+typedef int16_t i2c_status_t;
+
+#define I2C_STATUS_SUCCESS (0)
+#define I2C_STATUS_ERROR (-1)
+#define I2C_STATUS_TIMEOUT (-2)
+
+void         i2c_init(void);
+i2c_status_t i2c_start(uint8_t address);
+i2c_status_t i2c_transmit(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout);
+i2c_status_t i2c_receive(uint8_t address, uint8_t* data, uint16_t length, uint16_t timeout);
+i2c_status_t i2c_writeReg(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout);
+i2c_status_t i2c_writeReg16(uint8_t devaddr, uint16_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout);
+i2c_status_t i2c_readReg(uint8_t devaddr, uint8_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout);
+i2c_status_t i2c_readReg16(uint8_t devaddr, uint16_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout);
+void         i2c_stop(void);
+
+/* Clears the counters, but not the register images */
+void i2c_mock_reset(void);
+
+/* Number of transmissions since the last reset, each one costing a start, the address byte and a stop on the bus */
+uint32_t i2c_mock_transmissions(void);
+
+/* Number of data bytes transmitted since the last reset, register addresses included */
+uint32_t i2c_mock_bytes_transmitted(void);
+
+/* The 256 registers of the device at `address`, as last written */
+const uint8_t* i2c_mock_registers(uint8_t address);
@@ -0,0 +1,211 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+
+#include "serial.h"
+#include "serial_loopback.h"
+#include "transport.h"
+#include "transaction_id_define.h"
+
+void advance_time(uint32_t ms);
+
+// Provided by serial_loopback_slave.c
+extern split_transaction_desc_t serial_loopback_slave_table[NUM_TOTAL_TRANSACTIONS];
+void                            serial_loopback_slave_transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
+
+static split_shared_memory_t serial_loopback_slave_memory;
+split_shared_memory_t *const serial_loopback_slave_shmem = &serial_loopback_slave_memory;
+
+#define slave_shmem_offset_ptr(offset) (((uint8_t *)serial_loopback_slave_shmem) + (offset))
+
+static serial_loopback_config_t loopback_config = {0};
+static serial_loopback_stats_t  loopback_stats[NUM_TOTAL_TRANSACTIONS];
+static uint32_t                 loopback_link_time_us = 0;
+static uint32_t                 loopback_carry_us     = 0;
+static uint32_t                 loopback_rng          = 1;
+
+// The slave's own copies of the keyboard state it is sent
+#if !defined(NO_ACTION_LAYER) && defined(SPLIT_LAYER_STATE_ENABLE)
+layer_state_t serial_loopback_slave_layer_state;
+layer_state_t serial_loopback_slave_default_layer_state;
+#endif
+
+#ifdef SPLIT_MODS_ENABLE
+split_mods_sync_t serial_loopback_slave_mods;
+
+void serial_loopback_slave_set_mods(uint8_t mods) {
+    serial_loopback_slave_mods.real_mods = mods;
+}
+
+void serial_loopback_slave_set_weak_mods(uint8_t mods) {
+    serial_loopback_slave_mods.weak_mods = mods;
+}
+
+#    ifndef NO_ACTION_ONESHOT
+void serial_loopback_slave_set_oneshot_mods(uint8_t mods) {
+    serial_loopback_slave_mods.oneshot_mods = mods;
+}
+#    endif
+#endif
+
+#if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
+// Stands in for rgb_matrix_config on the slave
+rgb_config_t serial_loopback_slave_rgb_matrix_config;
+#endif
+
+#if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT) && defined(SPLIT_RGB_MATRIX_COLORS_ENABLE)
+static rgb_matrix_split_color_t loopback_slave_colors[RGB_MATRIX_LED_COUNT];
+static uint32_t                 loopback_slave_color_updates[RGB_MATRIX_LED_COUNT];
+
+// Stands in for rgb_matrix_split_colors_receive() on the slave
+void serial_loopback_slave_rgb_matrix_colors_receive(const rgb_matrix_split_color_t *colors, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        if (colors[i].index < RGB_MATRIX_LED_COUNT) {
+            loopback_slave_colors[colors[i].index] = colors[i];
+            loopback_slave_color_updates[colors[i].index]++;
+        }
+    }
+}
+
+uint32_t serial_loopback_slave_rgb_matrix_color(uint8_t index, rgb_matrix_split_color_t *color) {
+    if (index >= RGB_MATRIX_LED_COUNT) {
+        return 0;
+    }
+    *color = loopback_slave_colors[index];
+    return loopback_slave_color_updates[index];
+}
+#endif
+
+void soft_serial_initiator_init(void) {}
+
+void soft_serial_target_init(void) {}
+
+static uint32_t loopback_random(void) {
+    // xorshift32, so a given seed always damages the same bytes
+    loopback_rng ^= loopback_rng << 13;
+    loopback_rng ^= loopback_rng >> 17;
+    loopback_rng ^= loopback_rng << 5;
+    return loopback_rng;
+}
+
+static bool loopback_chance(uint32_t ppm) {
+    return ppm > 0 && loopback_random() % 1000000 < ppm;
+}
+
+// Moves one direction of a transfer, returning how many bytes made it before one was lost
+static uint16_t loopback_send(uint8_t *destination, const uint8_t *source, uint16_t length) {
+    for (uint16_t i = 0; i < length; i++) {
+        if (loopback_chance(loopback_config.drop_ppm)) {
+            return i;
+        }
+        uint8_t byte = source[i];
+        if (loopback_chance(loopback_config.flip_ppm)) {
+            byte ^= 1 << (loopback_random() % 8);
+        }
+        destination[i] = byte;
+    }
+    return length;
+}
+
+static void loopback_spend(serial_loopback_stats_t *stats, uint32_t bytes, bool failed) {
+    uint32_t us = loopback_config.latency_us;
+    if (loopback_config.bytes_per_second > 0) {
+        us += (uint64_t)bytes * 1000000 / loopback_config.bytes_per_second;
+    }
+    if (failed) {
+        us += loopback_config.timeout_us;
+    }
+
+    stats->link_time_us += us;
+    loopback_link_time_us += us;
+
+    // The test timer only counts whole milliseconds
+    loopback_carry_us += us;
+    advance_time(loopback_carry_us / 1000);
+    loopback_carry_us %= 1000;
+}
+
+bool soft_serial_transaction(int index) {
+    split_transaction_desc_t *initiator = &split_transaction_table[index];
+    split_transaction_desc_t *target    = &serial_loopback_slave_table[index];
+    serial_loopback_stats_t  *stats     = &loopback_stats[index];
+    uint32_t                  bytes     = 0;
+
+    stats->transfers++;
+
+    // Both sides must agree on the sizes, as a real link would lose sync otherwise
+    bool okay = initiator->initiator2target_buffer_size == target->initiator2target_buffer_size && initiator->target2initiator_buffer_size == target->target2initiator_buffer_size;
+
+    if (okay && initiator->initiator2target_buffer_size) {
+        // The target reads the header before it knows how much more is coming
+        uint8_t *destination = slave_shmem_offset_ptr(target->initiator2target_offset);
+        uint8_t  header      = split_trans_initiator2target_header(index, target);
+        uint16_t sent        = loopback_send(destination, split_trans_initiator2target_buffer(initiator), header);
+        uint8_t  length      = split_trans_initiator2target_length(index, target, destination);
+        okay                 = sent == header && length >= header;
+        if (okay) {
+            sent += loopback_send(destination + header, split_trans_initiator2target_buffer(initiator) + header, length - header);
+            okay = sent == length;
+        }
+        bytes += sent;
+        stats->bytes_out += sent;
+    }
+
+    if (okay && target->slave_callback) {
+        target->slave_callback(target->initiator2target_buffer_size, slave_shmem_offset_ptr(target->initiator2target_offset), target->target2initiator_buffer_size, slave_shmem_offset_ptr(target->target2initiator_offset));
+    }
+
+    if (okay && initiator->target2initiator_buffer_size) {
+        uint16_t sent = loopback_send(split_trans_target2initiator_buffer(initiator), slave_shmem_offset_ptr(target->target2initiator_offset), initiator->target2initiator_buffer_size);
+        okay          = sent == initiator->target2initiator_buffer_size;
+        bytes += sent;
+        stats->bytes_in += sent;
+    }
+
+    if (!okay) {
+        stats->failures++;
+    }
+    loopback_spend(stats, bytes, !okay);
+    return okay;
+}
+
+void serial_loopback_reset(const serial_loopback_config_t *config) {
+    if (config) {
+        loopback_config = *config;
+    } else {
+        memset(&loopback_config, 0, sizeof(loopback_config));
+    }
+    loopback_rng = loopback_config.seed ? loopback_config.seed : 1;
+
+    memset(split_shmem, 0, sizeof(split_shared_memory_t));
+    memset(serial_loopback_slave_shmem, 0, sizeof(split_shared_memory_t));
+    memset(loopback_stats, 0, sizeof(loopback_stats));
+    loopback_link_time_us = 0;
+    loopback_carry_us     = 0;
+#if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT) && defined(SPLIT_RGB_MATRIX_COLORS_ENABLE)
+    memset(loopback_slave_colors, 0, sizeof(loopback_slave_colors));
+    memset(loopback_slave_color_updates, 0, sizeof(loopback_slave_color_updates));
+#endif
+}
+
+void serial_loopback_clear_stats(void) {
+    memset(loopback_stats, 0, sizeof(loopback_stats));
+    loopback_link_time_us = 0;
+}
+
+void serial_loopback_slave_scan(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    serial_loopback_slave_transactions_slave(master_matrix, slave_matrix);
+}
+
+void serial_loopback_get_stats(int8_t id, serial_loopback_stats_t *stats) {
+    if (id < 0 || id >= NUM_TOTAL_TRANSACTIONS) {
+        memset(stats, 0, sizeof(*stats));
+        return;
+    }
+    *stats = loopback_stats[id];
+}
+
+uint32_t serial_loopback_link_time_us(void) {
+    return loopback_link_time_us;
+}
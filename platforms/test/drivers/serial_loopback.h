@@ -0,0 +1,72 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+/*
+    An in-memory split link for the test platform, selected with SERIAL_DRIVER = loopback.
+
+    The master half is the regular build. The slave half is a second copy of transactions.c
+    with its own split_shmem, and runs whenever the test calls serial_loopback_slave_scan().
+    soft_serial_transaction() moves each transaction's buffers between the two copies in
+    the order serial_protocol.c uses: request, slave callback, response.
+
+    The link can be slowed down and made lossy. Transfer time is added to the test timer,
+    so throttles and timeouts in the split code see it.
+
+    The slave keeps its own layer state, mods and RGB matrix config, declared below, so
+    tests can check what it received. Its received SPLIT_RGB_MATRIX_COLORS_ENABLE colors are
+    read back with serial_loopback_slave_rgb_matrix_color(). Other state the slave is sent,
+    such as the LED state, backlight, RGB light and WPM, is still the master's own globals.
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "matrix.h"
+#include "transactions.h"
+#include "transport.h"
+
+typedef struct {
+    uint32_t bytes_per_second; // 0 for a link that takes no time per byte
+    uint32_t latency_us;       // added to every transfer, for the handshake between the halves
+    uint32_t timeout_us;       // time spent waiting when a byte is lost
+    uint32_t drop_ppm;         // chance in a million that a byte is lost, failing the transfer
+    uint32_t flip_ppm;         // chance in a million that a byte arrives with one bit flipped
+    uint32_t seed;
+} serial_loopback_config_t;
+
+typedef struct {
+    uint32_t transfers; // attempts, including the failed ones
+    uint32_t failures;
+    uint32_t bytes_out;
+    uint32_t bytes_in;
+    uint32_t link_time_us;
+} serial_loopback_stats_t;
+
+/* The slave's shared memory, as the slave half's transactions.c sees it */
+extern split_shared_memory_t *const serial_loopback_slave_shmem;
+
+/* Clears both halves' shared memory and the statistics, and applies config (NULL for an ideal link) */
+void serial_loopback_reset(const serial_loopback_config_t *config);
+
+void serial_loopback_slave_scan(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
+void serial_loopback_slave_register_rpc(int8_t transaction_id, slave_callback_t callback);
+
+/* Clears the statistics only, leaving the link and both halves as they are */
+void     serial_loopback_clear_stats(void);
+void     serial_loopback_get_stats(int8_t id, serial_loopback_stats_t *stats);
+uint32_t serial_loopback_link_time_us(void);
+
+#if !defined(NO_ACTION_LAYER) && defined(SPLIT_LAYER_STATE_ENABLE)
+extern layer_state_t serial_loopback_slave_layer_state;
+extern layer_state_t serial_loopback_slave_default_layer_state;
+#endif
+
+#ifdef SPLIT_MODS_ENABLE
+extern split_mods_sync_t serial_loopback_slave_mods;
+#endif
+
+#if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT) && defined(SPLIT_RGB_MATRIX_COLORS_ENABLE)
+/* The last color the slave received for an LED, returning how many times it was received */
+uint32_t serial_loopback_slave_rgb_matrix_color(uint8_t index, rgb_matrix_split_color_t *color);
+#endif
@@ -0,0 +1,36 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// The slave half of the loopback link: transactions.c again, with its own shared memory
+// and transaction table. Keyboard state the slave is sent, such as layers, mods and the RGB
+// matrix config, would otherwise land in the master's own globals, so the slave keeps its
+// copies in serial_loopback.c. The rest, such as the LED state, backlight, RGB light and
+// WPM, is still shared with the master.
+
+#define split_shmem serial_loopback_slave_shmem
+#define split_transaction_table serial_loopback_slave_table
+#define transactions_master serial_loopback_slave_transactions_master
+#define transactions_slave serial_loopback_slave_transactions_slave
+#define transactions_scheduler_charge serial_loopback_slave_scheduler_charge
+#define transaction_register_rpc serial_loopback_slave_register_rpc
+#define transaction_rpc_exec serial_loopback_slave_rpc_exec
+#define transaction_rpc_exec_async serial_loopback_slave_rpc_exec_async
+#define slave_rpc_info_callback serial_loopback_slave_rpc_info_callback
+#define slave_rpc_exec_callback serial_loopback_slave_rpc_exec_callback
+#define transport_execute_transaction serial_loopback_slave_execute_transaction
+#define layer_state serial_loopback_slave_layer_state
+// The master handler macros paste layer_state after it has been renamed above
+#define serial_loopback_slave_layer_state_handlers_master layer_state_handlers_master
+#define default_layer_state serial_loopback_slave_default_layer_state
+#define set_mods serial_loopback_slave_set_mods
+#define set_weak_mods serial_loopback_slave_set_weak_mods
+#define set_oneshot_mods serial_loopback_slave_set_oneshot_mods
+#define rgb_matrix_config serial_loopback_slave_rgb_matrix_config
+#define rgb_matrix_split_colors_receive serial_loopback_slave_rgb_matrix_colors_receive
+
+#include "transactions.c"
+
+// The slave never starts a transfer
+bool serial_loopback_slave_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+    return false;
+}
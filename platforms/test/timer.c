@@ -60,6 +60,10 @@ uint32_t timer_read32(void) {
     return current_time;
 }
 
+uint32_t timer_read_us(void) {
+    return current_time * 1000;
+}
+
 uint16_t timer_elapsed(uint16_t last) {
     return TIMER_DIFF_16(timer_read(), last);
 }
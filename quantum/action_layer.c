@@ -1,5 +1,6 @@
 #include <limits.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "keyboard.h"
 #include "action.h"
@@ -301,6 +302,25 @@ uint8_t read_source_layers_cache(keypos_t key) {
 }
 #endif
 
+#if !defined(NO_ACTION_LAYER) && defined(RESOLVED_LAYER_CACHE)
+/** \brief resolved layer cache
+ *
+ * Topmost non-transparent layer of each matrix position, for resolved_layer_cache_state only.
+ * Entries are filled in on first lookup, so a layer change costs nothing until a key is pressed.
+ */
+static uint8_t       resolved_layer_cache[MATRIX_ROWS * MATRIX_COLS];
+static uint8_t       resolved_layer_cache_valid[((MATRIX_ROWS * MATRIX_COLS) + (CHAR_BIT)-1) / (CHAR_BIT)];
+static layer_state_t resolved_layer_cache_state = 0;
+
+/** \brief resolved layer cache invalidate
+ *
+ * Drops all cached layers, must be called whenever the keymap changes
+ */
+void resolved_layer_cache_invalidate(void) {
+    memset(resolved_layer_cache_valid, 0, sizeof(resolved_layer_cache_valid));
+}
+#endif
+
 /** \brief Store or get action (FIXME: Needs better summary)
  *
  * Make sure the action triggered when the key is released is the same
@@ -338,17 +358,37 @@ uint8_t layer_switch_get_layer(keypos_t key) {
     action.code = ACTION_TRANSPARENT;
 
     layer_state_t layers = layer_state | default_layer_state;
-    /* check top layer first */
+#    ifdef RESOLVED_LAYER_CACHE
+    const bool     cacheable    = key.row < MATRIX_ROWS && key.col < MATRIX_COLS;
+    const uint16_t entry_number = (uint16_t)(key.row * MATRIX_COLS) + key.col;
+    if (cacheable) {
+        if (layers != resolved_layer_cache_state) {
+            resolved_layer_cache_invalidate();
+            resolved_layer_cache_state = layers;
+        }
+        if (resolved_layer_cache_valid[entry_number / (CHAR_BIT)] & (1U << (entry_number % (CHAR_BIT)))) {
+            return resolved_layer_cache[entry_number];
+        }
+    }
+#    endif
+    /* check top layer first, falling back to layer 0 */
+    uint8_t layer = 0;
     for (int8_t i = MAX_LAYER - 1; i >= 0; i--) {
         if (layers & ((layer_state_t)1 << i)) {
             action = action_for_key(i, key);
             if (action.code != ACTION_TRANSPARENT) {
-                return i;
+                layer = i;
+                break;
             }
         }
     }
-    /* fall back to layer 0 */
-    return 0;
+#    ifdef RESOLVED_LAYER_CACHE
+    if (cacheable) {
+        resolved_layer_cache[entry_number] = layer;
+        resolved_layer_cache_valid[entry_number / (CHAR_BIT)] |= 1U << (entry_number % (CHAR_BIT));
+    }
+#    endif
+    return layer;
 #else
     return get_highest_layer(default_layer_state);
 #endif
@@ -112,6 +112,33 @@ void action_tapping_process(keyrecord_t record) {
     }
 }
 
+/** \brief Number of key events queued in the waiting buffer while the tapping key is undecided
+ */
+uint8_t action_tapping_waiting_buffer_count(void) {
+    return (waiting_buffer_head + WAITING_BUFFER_SIZE - waiting_buffer_tail) % WAITING_BUFFER_SIZE;
+}
+
+/** \brief Time until the tapping key needs a tick event
+ *
+ * Returns the milliseconds left in the tapping term of the current tapping key, 0 when the
+ * term has run out and the next tick event will resolve it, or UINT32_MAX when there is
+ * nothing to time out.
+ */
+uint32_t action_tapping_next_deadline(void) {
+    if (IS_NOEVENT(tapping_key.event)) {
+        return UINT32_MAX;
+    }
+
+    uint16_t elapsed = TIMER_DIFF_16(timer_read(), tapping_key.event.time);
+    uint16_t term    = GET_TAPPING_TERM(get_record_keycode(&tapping_key, false), &tapping_key);
+    if (elapsed < term) {
+        return term - elapsed;
+    }
+
+    // A tapped key that is held again past the term stays tapping_key until it is released
+    return tapping_key.event.pressed && tapping_key.tap.count > 0 ? UINT32_MAX : 0;
+}
+
 /* Some conditionally defined helper macros to keep process_tapping more
  * readable. The conditional definition of tapping_keycode and all the
  * conditional uses of it are hidden inside macros named TAP_...
@@ -238,6 +238,38 @@ bool is_oneshot_enabled(void) {
     return keymap_config.oneshot_enable;
 }
 
+static void oneshot_update_deadline(uint32_t *deadline, uint16_t start) {
+    uint16_t elapsed = TIMER_DIFF_16(timer_read(), start);
+    uint32_t left    = elapsed < QS_oneshot_timeout ? QS_oneshot_timeout - elapsed : 0;
+    if (left < *deadline) {
+        *deadline = left;
+    }
+}
+
+/** \brief Time until a one-shot mod, layer or swap hands times out
+ *
+ * Returns the milliseconds left, 0 when a timeout is due, or UINT32_MAX when nothing can time out.
+ */
+uint32_t oneshot_next_deadline(void) {
+    uint32_t deadline = UINT32_MAX;
+    if (!keymap_config.oneshot_enable || QS_oneshot_timeout == 0) {
+        return deadline;
+    }
+
+    if (oneshot_mods) {
+        oneshot_update_deadline(&deadline, oneshot_time);
+    }
+    if (get_oneshot_layer_state() && !(get_oneshot_layer_state() & ONESHOT_TOGGLED)) {
+        oneshot_update_deadline(&deadline, oneshot_layer_time);
+    }
+#    ifdef SWAP_HANDS_ENABLE
+    if (swap_hands_oneshot == SHO_ACTIVE) {
+        oneshot_update_deadline(&deadline, oneshot_swaphands_time);
+    }
+#    endif
+    return deadline;
+}
+
 #endif
 
 static uint8_t get_mods_for_report(void) {
@@ -0,0 +1,184 @@
+/*
+Copyright 2024 QMK
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+Symmetric per-key algorithm with vertical counters, behaving exactly like sym_defer_pk.
+When no state changes have occured for DEBOUNCE milliseconds, we push the state.
+
+Instead of one 8-bit counter per key, bit n of every key's counter in a row is stored
+together in bit-plane n, a matrix_row_t. Counting down all the keys of a row is then a
+ripple-borrow subtraction over the planes, a few word-wide operations per plane, rather
+than a loop over the columns.
+*/
+
+#include "debounce.h"
+#include "timer.h"
+#include <stdlib.h>
+
+#ifdef PROTOCOL_CHIBIOS
+#    if CH_CFG_USE_MEMCORE == FALSE
+#        error ChibiOS is configured without a memory allocator. Your keyboard may have set `#define CH_CFG_USE_MEMCORE FALSE`, which is incompatible with this debounce algorithm.
+#    endif
+#endif
+
+#ifndef DEBOUNCE
+#    define DEBOUNCE 5
+#endif
+
+// Maximum debounce: 255ms
+#if DEBOUNCE > UINT8_MAX
+#    undef DEBOUNCE
+#    define DEBOUNCE UINT8_MAX
+#endif
+
+// Number of bit-planes needed to hold DEBOUNCE
+#if DEBOUNCE < 2
+#    define DEBOUNCE_PLANES 1
+#elif DEBOUNCE < 4
+#    define DEBOUNCE_PLANES 2
+#elif DEBOUNCE < 8
+#    define DEBOUNCE_PLANES 3
+#elif DEBOUNCE < 16
+#    define DEBOUNCE_PLANES 4
+#elif DEBOUNCE < 32
+#    define DEBOUNCE_PLANES 5
+#elif DEBOUNCE < 64
+#    define DEBOUNCE_PLANES 6
+#elif DEBOUNCE < 128
+#    define DEBOUNCE_PLANES 7
+#else
+#    define DEBOUNCE_PLANES 8
+#endif
+
+#if DEBOUNCE > 0
+static matrix_row_t *debounce_planes;
+static fast_timer_t  last_time;
+static bool          counters_need_update;
+static bool          cooked_changed;
+
+static void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t elapsed_time);
+static void start_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows);
+
+// we use num_rows rather than MATRIX_ROWS to support split keyboards
+void debounce_init(uint8_t num_rows) {
+    debounce_planes = (matrix_row_t *)calloc(num_rows * DEBOUNCE_PLANES, sizeof(matrix_row_t));
+}
+
+void debounce_free(void) {
+    free(debounce_planes);
+    debounce_planes = NULL;
+}
+
+bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
+    bool updated_last = false;
+    cooked_changed    = false;
+
+    if (counters_need_update) {
+        fast_timer_t now          = timer_read_fast();
+        fast_timer_t elapsed_time = TIMER_DIFF_FAST(now, last_time);
+
+        last_time    = now;
+        updated_last = true;
+        if (elapsed_time > UINT8_MAX) {
+            elapsed_time = UINT8_MAX;
+        }
+
+        if (elapsed_time > 0) {
+            update_debounce_counters_and_transfer_if_expired(raw, cooked, num_rows, elapsed_time);
+        }
+    }
+
+    if (changed) {
+        if (!updated_last) {
+            last_time = timer_read_fast();
+        }
+
+        start_debounce_counters(raw, cooked, num_rows);
+    }
+
+    return cooked_changed;
+}
+
+static void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t elapsed_time) {
+    counters_need_update = false;
+    matrix_row_t *planes = debounce_planes;
+    for (uint8_t row = 0; row < num_rows; row++, planes += DEBOUNCE_PLANES) {
+        matrix_row_t active = 0;
+        for (uint8_t bit = 0; bit < DEBOUNCE_PLANES; bit++) {
+            active |= planes[bit];
+        }
+        if (!active) {
+            continue;
+        }
+
+        // counter -= elapsed_time for all keys at once, the final borrow flags the keys that went below zero
+        matrix_row_t borrow    = 0;
+        matrix_row_t remaining = 0;
+        for (uint8_t bit = 0; bit < DEBOUNCE_PLANES; bit++) {
+            matrix_row_t plane = planes[bit];
+            if (elapsed_time & (1 << bit)) {
+                planes[bit] = ~(plane ^ borrow);
+                borrow      = ~plane | borrow;
+            } else {
+                planes[bit] = plane ^ borrow;
+                borrow      = ~plane & borrow;
+            }
+            remaining |= planes[bit];
+        }
+        if (elapsed_time >> DEBOUNCE_PLANES) {
+            borrow = ~(matrix_row_t)0;
+        }
+
+        // Idle keys went negative too, so only keep the counters that are still running
+        matrix_row_t expired = active & (borrow | ~remaining);
+        for (uint8_t bit = 0; bit < DEBOUNCE_PLANES; bit++) {
+            planes[bit] &= active & ~expired;
+        }
+        if (expired) {
+            matrix_row_t cooked_next = (cooked[row] & ~expired) | (raw[row] & expired);
+            cooked_changed |= cooked[row] ^ cooked_next;
+            cooked[row] = cooked_next;
+        }
+        if (active & ~expired) {
+            counters_need_update = true;
+        }
+    }
+}
+
+static void start_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows) {
+    matrix_row_t *planes = debounce_planes;
+    for (uint8_t row = 0; row < num_rows; row++, planes += DEBOUNCE_PLANES) {
+        matrix_row_t delta  = raw[row] ^ cooked[row];
+        matrix_row_t active = 0;
+        for (uint8_t bit = 0; bit < DEBOUNCE_PLANES; bit++) {
+            active |= planes[bit];
+        }
+
+        // Keys that went back to their debounced state stop counting, keys that newly differ start at DEBOUNCE
+        matrix_row_t start = delta & ~active;
+        for (uint8_t bit = 0; bit < DEBOUNCE_PLANES; bit++) {
+            planes[bit] &= delta;
+            if (DEBOUNCE & (1 << bit)) {
+                planes[bit] |= start;
+            }
+        }
+        if (start) {
+            counters_need_update = true;
+        }
+    }
+}
+
+#else
+#    include "none.c"
+#endif
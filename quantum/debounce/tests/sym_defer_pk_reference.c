@@ -0,0 +1,10 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/* sym_defer_pk built under other names, as the reference for algorithms that must behave identically */
+
+#define debounce debounce_reference
+#define debounce_init debounce_reference_init
+#define debounce_free debounce_reference_free
+
+#include "../sym_defer_pk.c"
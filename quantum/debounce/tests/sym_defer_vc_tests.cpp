@@ -0,0 +1,122 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+extern "C" {
+#include "debounce.h"
+#include "timer.h"
+
+bool debounce_reference(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed);
+void debounce_reference_init(uint8_t num_rows);
+void debounce_reference_free(void);
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+namespace {
+
+/* Small self-contained PRNG, so that failures reproduce with every standard library */
+class DebounceRandom {
+   public:
+    explicit DebounceRandom(uint32_t seed) : m_state(seed) {}
+
+    uint32_t next() {
+        m_state ^= m_state << 13;
+        m_state ^= m_state >> 17;
+        m_state ^= m_state << 5;
+        return m_state;
+    }
+
+    uint32_t uniform(uint32_t range) {
+        return next() % range;
+    }
+
+   private:
+    uint32_t m_state;
+};
+
+class DebounceVerticalCounterTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        set_time(1234);
+        debounce_init(MATRIX_ROWS);
+        debounce_reference_init(MATRIX_ROWS);
+    }
+
+    void TearDown() override {
+        debounce_free();
+        debounce_reference_free();
+    }
+
+    /* Toggles a few random keys, chattering ones a lot more often than the rest */
+    void bounce(DebounceRandom &rng, matrix_row_t raw[]) {
+        uint8_t toggles = rng.uniform(4);
+        for (uint8_t i = 0; i < toggles; i++) {
+            uint8_t row = rng.uniform(MATRIX_ROWS);
+            uint8_t col = rng.uniform(4) ? rng.uniform(4) : rng.uniform(MATRIX_COLS);
+            raw[row] ^= (matrix_row_t)1 << col;
+        }
+    }
+
+    /* Mostly 1ms scans, with the odd stall long enough to overflow the counters */
+    void advance(DebounceRandom &rng) {
+        uint32_t roll = rng.uniform(100);
+        advance_time(roll < 80 ? 1 : roll < 95 ? rng.uniform(DEBOUNCE + 2) : rng.uniform(600));
+    }
+};
+
+} // namespace
+
+TEST_F(DebounceVerticalCounterTest, MatchesPerKeyCounters) {
+    DebounceRandom rng(0x5eed);
+    matrix_row_t   raw[MATRIX_ROWS]              = {0};
+    matrix_row_t   cooked[MATRIX_ROWS]           = {0};
+    matrix_row_t   reference_cooked[MATRIX_ROWS] = {0};
+
+    for (uint32_t scan = 0; scan < 200000; scan++) {
+        matrix_row_t previous[MATRIX_ROWS];
+        memcpy(previous, raw, sizeof(raw));
+        bounce(rng, raw);
+        bool changed = memcmp(previous, raw, sizeof(raw)) != 0;
+
+        bool cooked_changed    = debounce(raw, cooked, MATRIX_ROWS, changed);
+        bool reference_changed = debounce_reference(raw, reference_cooked, MATRIX_ROWS, changed);
+        ASSERT_EQ(reference_changed, cooked_changed) << "scan " << scan;
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            ASSERT_EQ(reference_cooked[row], cooked[row]) << "scan " << scan << " row " << +row;
+        }
+
+        advance(rng);
+    }
+}
+
+TEST_F(DebounceVerticalCounterTest, Throughput) {
+    const uint32_t scans = 200000;
+    DebounceRandom rng(0xbeef);
+    matrix_row_t   raw[MATRIX_ROWS]    = {0};
+    matrix_row_t   cooked[MATRIX_ROWS] = {0};
+
+    auto measure = [&](const char *name, bool (*algorithm)(matrix_row_t[], matrix_row_t[], uint8_t, bool)) {
+        DebounceRandom scan_rng = rng;
+        auto           start    = std::chrono::steady_clock::now();
+        for (uint32_t scan = 0; scan < scans; scan++) {
+            bool changed = scan_rng.uniform(8) == 0;
+            if (changed) {
+                bounce(scan_rng, raw);
+            }
+            algorithm(raw, cooked, MATRIX_ROWS, changed);
+            advance_time(1);
+        }
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "[ DEBOUNCE ] " << name << ": " << ns / scans << " ns/scan (" << MATRIX_ROWS << "x" << MATRIX_COLS << ")" << std::endl;
+    };
+
+    measure("sym_defer_pk", debounce_reference);
+    measure("sym_defer_vc", debounce);
+}
@@ -150,6 +150,24 @@ void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count,
     }
 }
 
+uint32_t deferred_exec_advanced_next_deadline(deferred_executor_t *table, size_t table_count) {
+    uint32_t now      = timer_read32();
+    uint32_t deadline = UINT32_MAX;
+    for (int i = 0; i < table_count; ++i) {
+        deferred_executor_t *entry = &table[i];
+        if (entry->token != INVALID_DEFERRED_TOKEN) {
+            int32_t remaining = (int32_t)TIMER_DIFF_32(entry->trigger_time, now);
+            if (remaining <= 0) {
+                return 0;
+            }
+            if ((uint32_t)remaining < deadline) {
+                deadline = remaining;
+            }
+        }
+    }
+    return deadline;
+}
+
 //------------------------------------
 // Basic API: used by user-mode code, guaranteed to not collide with core deferred execution
 //
@@ -169,3 +187,6 @@ bool cancel_deferred_exec(deferred_token token) {
 void deferred_exec_task(void) {
     deferred_exec_advanced_task(basic_executors, MAX_DEFERRED_EXECUTORS, &last_deferred_exec_check);
 }
+uint32_t deferred_exec_next_deadline(void) {
+    return deferred_exec_advanced_next_deadline(basic_executors, MAX_DEFERRED_EXECUTORS);
+}
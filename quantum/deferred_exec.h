@@ -65,6 +65,11 @@ bool cancel_deferred_exec(deferred_token token);
  */
 void deferred_exec_task(void);
 
+/**
+ * Returns the number of milliseconds until the next deferred executor is due, 0 if one is already due, or UINT32_MAX if none are queued.
+ */
+uint32_t deferred_exec_next_deadline(void);
+
 //------------------------------------
 // Advanced API: used when a custom-allocated table is used, primarily for core code.
 //------------------------------------
@@ -119,3 +124,11 @@ bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_coun
  * @param last_execution_time[in,out] the last execution time -- this will be checked first to determine if execution is needed, and updated if execution occurred
  */
 void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count, uint32_t *last_execution_time);
+
+/**
+ * Returns the number of milliseconds until the next executor in the supplied table is due, 0 if one is already due, or UINT32_MAX if none are queued.
+ *
+ * @param table[in] the custom table used for storage
+ * @param table_count[in] the number of available items in the table
+ */
+uint32_t deferred_exec_advanced_next_deadline(deferred_executor_t *table, size_t table_count);
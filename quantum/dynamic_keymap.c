@@ -17,6 +17,7 @@
 #include "dynamic_keymap.h"
 #include "keymap_introspection.h"
 #include "action.h"
+#include "action_layer.h"
 #include "eeprom.h"
 #include "progmem.h"
 #include "send_string.h"
@@ -25,6 +26,10 @@
 #include "wait.h"
 #include <string.h>
 
+#ifdef DEFERRED_EXEC_ENABLE
+#    include "deferred_exec.h"
+#endif
+
 #ifdef VIA_ENABLE
 #    include "via.h"
 #    define DYNAMIC_KEYMAP_EEPROM_START (VIA_EEPROM_CONFIG_END)
@@ -132,6 +137,58 @@ _Static_assert(DYNAMIC_KEYMAP_EEPROM_MAX_ADDR >= DYNAMIC_KEYMAP_MACRO_EEPROM_ADD
 #    define DYNAMIC_KEYMAP_MACRO_DELAY TAP_CODE_DELAY
 #endif
 
+#ifndef DYNAMIC_KEYMAP_MACRO_QUEUE_SIZE
+#    define DYNAMIC_KEYMAP_MACRO_QUEUE_SIZE 4
+#endif
+
+#ifndef DYNAMIC_KEYMAP_MACRO_HELD_KEYS
+#    define DYNAMIC_KEYMAP_MACRO_HELD_KEYS 8
+#endif
+
+#define DYNAMIC_KEYMAP_KEY_COUNT (DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS)
+
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+// Host-endian copy of the keymap (and encoder map), so that key lookups never touch the EEPROM driver.
+// Kept coherent by writing through from every setter below.
+static uint16_t dynamic_keymap_cache[DYNAMIC_KEYMAP_KEY_COUNT];
+#    ifdef ENCODER_MAP_ENABLE
+static uint16_t dynamic_encodermap_cache[DYNAMIC_KEYMAP_LAYER_COUNT][NUM_ENCODERS][2];
+#    endif
+
+static inline uint16_t dynamic_keymap_cache_index(uint8_t layer, uint8_t row, uint8_t column) {
+    return (layer * MATRIX_ROWS * MATRIX_COLS) + (row * MATRIX_COLS) + column;
+}
+
+// Applies a single byte written to the big-endian EEPROM image at the given keymap offset
+static inline void dynamic_keymap_cache_update_byte(uint16_t offset, uint8_t value) {
+    uint16_t *keycode = &dynamic_keymap_cache[offset / 2];
+    if (offset % 2 == 0) {
+        *keycode = (*keycode & 0x00FF) | ((uint16_t)value << 8);
+    } else {
+        *keycode = (*keycode & 0xFF00) | value;
+    }
+}
+#endif // DYNAMIC_KEYMAP_RAM_CACHE
+
+void dynamic_keymap_init(void) {
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+    // Read the whole keymap in one go, then fix up the byte order in place
+    eeprom_read_block(dynamic_keymap_cache, (void *)DYNAMIC_KEYMAP_EEPROM_ADDR, sizeof(dynamic_keymap_cache));
+    for (uint16_t i = 0; i < DYNAMIC_KEYMAP_KEY_COUNT; i++) {
+        uint8_t *bytes          = (uint8_t *)&dynamic_keymap_cache[i];
+        dynamic_keymap_cache[i] = ((uint16_t)bytes[0] << 8) | bytes[1];
+    }
+#    ifdef ENCODER_MAP_ENABLE
+    eeprom_read_block(dynamic_encodermap_cache, (void *)DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR, sizeof(dynamic_encodermap_cache));
+    uint16_t *encodermap = &dynamic_encodermap_cache[0][0][0];
+    for (uint16_t i = 0; i < sizeof(dynamic_encodermap_cache) / sizeof(uint16_t); i++) {
+        uint8_t *bytes = (uint8_t *)&encodermap[i];
+        encodermap[i]  = ((uint16_t)bytes[0] << 8) | bytes[1];
+    }
+#    endif
+#endif // DYNAMIC_KEYMAP_RAM_CACHE
+}
+
 uint8_t dynamic_keymap_get_layer_count(void) {
     return DYNAMIC_KEYMAP_LAYER_COUNT;
 }
@@ -143,11 +200,15 @@ void *dynamic_keymap_key_to_eeprom_address(uint8_t layer, uint8_t row, uint8_t c
 
 uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column) {
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return KC_NO;
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+    return dynamic_keymap_cache[dynamic_keymap_cache_index(layer, row, column)];
+#else
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
     uint16_t keycode = eeprom_read_byte(address) << 8;
     keycode |= eeprom_read_byte(address + 1);
     return keycode;
+#endif
 }
 
 void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint16_t keycode) {
@@ -156,6 +217,10 @@ void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint
     // Big endian, so we can read/write EEPROM directly from host if we want
     eeprom_update_byte(address, (uint8_t)(keycode >> 8));
     eeprom_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+    dynamic_keymap_cache[dynamic_keymap_cache_index(layer, row, column)] = keycode;
+#endif
+    resolved_layer_cache_invalidate();
 }
 
 #ifdef ENCODER_MAP_ENABLE
@@ -165,11 +230,15 @@ void *dynamic_keymap_encoder_to_eeprom_address(uint8_t layer, uint8_t encoder_id
 
 uint16_t dynamic_keymap_get_encoder(uint8_t layer, uint8_t encoder_id, bool clockwise) {
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || encoder_id >= NUM_ENCODERS) return KC_NO;
+#    ifdef DYNAMIC_KEYMAP_RAM_CACHE
+    return dynamic_encodermap_cache[layer][encoder_id][clockwise ? 0 : 1];
+#    else
     void *address = dynamic_keymap_encoder_to_eeprom_address(layer, encoder_id);
     // Big endian, so we can read/write EEPROM directly from host if we want
     uint16_t keycode = ((uint16_t)eeprom_read_byte(address + (clockwise ? 0 : 2))) << 8;
     keycode |= eeprom_read_byte(address + (clockwise ? 0 : 2) + 1);
     return keycode;
+#    endif
 }
 
 void dynamic_keymap_set_encoder(uint8_t layer, uint8_t encoder_id, bool clockwise, uint16_t keycode) {
@@ -178,6 +247,9 @@ void dynamic_keymap_set_encoder(uint8_t layer, uint8_t encoder_id, bool clockwis
     // Big endian, so we can read/write EEPROM directly from host if we want
     eeprom_update_byte(address + (clockwise ? 0 : 2), (uint8_t)(keycode >> 8));
     eeprom_update_byte(address + (clockwise ? 0 : 2) + 1, (uint8_t)(keycode & 0xFF));
+#    ifdef DYNAMIC_KEYMAP_RAM_CACHE
+    dynamic_encodermap_cache[layer][encoder_id][clockwise ? 0 : 1] = keycode;
+#    endif
 }
 #endif // ENCODER_MAP_ENABLE
 
@@ -320,11 +392,16 @@ void dynamic_keymap_reset(void) {
 
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   source                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
+    void *   source                     = (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
     uint8_t *target                     = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < dynamic_keymap_eeprom_size) {
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+            uint16_t keycode = dynamic_keymap_cache[(offset + i) / 2];
+            *target          = ((offset + i) % 2 == 0) ? (keycode >> 8) : (keycode & 0xFF);
+#else
             *target = eeprom_read_byte(source);
+#endif
         } else {
             *target = 0x00;
         }
@@ -335,7 +412,7 @@ void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
 
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   target                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
+    void *   target                     = (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
     uint8_t *source                     = data;
 
 #ifdef VIAL_ENABLE
@@ -352,7 +429,11 @@ void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
 
         /* initial byte misaligned -- this means the first keycode will be a combination of existing and new data */
         if (offset % 2 != 0) {
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+            uint16_t kc = (dynamic_keymap_cache[offset / 2] & 0xFF00) | data[0];
+#else
             uint16_t kc = (eeprom_read_byte((uint8_t*)target - 1) << 8) | data[0];
+#endif
             if (kc == QK_BOOT)
                 data[0] = 0xFF;
 
@@ -362,7 +443,11 @@ void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
 
         /* final byte misaligned -- this means the last keycode will be a combination of new and existing data */
         if ((offset + size) % 2 != 0) {
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+            uint16_t kc = (data[size - 1] << 8) | (dynamic_keymap_cache[(offset + size) / 2] & 0xFF);
+#else
             uint16_t kc = (data[size - 1] << 8) | eeprom_read_byte((uint8_t*)target + size);
+#endif
             if (kc == QK_BOOT)
                 data[size - 1] = 0xFF;
 
@@ -385,10 +470,63 @@ void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < dynamic_keymap_eeprom_size) {
             eeprom_update_byte(target, *source);
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+            dynamic_keymap_cache_update_byte(offset + i, *source);
+#endif
         }
         source++;
         target++;
     }
+    resolved_layer_cache_invalidate();
+}
+
+uint16_t dynamic_keymap_get_key_count(void) {
+    return DYNAMIC_KEYMAP_KEY_COUNT;
+}
+
+// Keycodes are moved in chunks of this many, so EEPROM traffic is done in blocks rather than byte by byte
+#define DYNAMIC_KEYMAP_BULK_CHUNK 16
+
+void dynamic_keymap_get_keycodes(uint16_t index, uint16_t count, uint16_t *keycodes) {
+    if (index >= DYNAMIC_KEYMAP_KEY_COUNT) return;
+    if (count > DYNAMIC_KEYMAP_KEY_COUNT - index) count = DYNAMIC_KEYMAP_KEY_COUNT - index;
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+    memcpy(keycodes, &dynamic_keymap_cache[index], count * sizeof(uint16_t));
+#else
+    uint8_t buffer[DYNAMIC_KEYMAP_BULK_CHUNK * 2];
+    while (count > 0) {
+        uint16_t chunk = count < DYNAMIC_KEYMAP_BULK_CHUNK ? count : DYNAMIC_KEYMAP_BULK_CHUNK;
+        eeprom_read_block(buffer, (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + index * 2), chunk * 2);
+        for (uint16_t i = 0; i < chunk; i++) {
+            // Big endian, so we can read/write EEPROM directly from host if we want
+            keycodes[i] = ((uint16_t)buffer[i * 2] << 8) | buffer[i * 2 + 1];
+        }
+        index += chunk;
+        keycodes += chunk;
+        count -= chunk;
+    }
+#endif
+}
+
+void dynamic_keymap_set_keycodes(uint16_t index, uint16_t count, const uint16_t *keycodes) {
+    if (index >= DYNAMIC_KEYMAP_KEY_COUNT) return;
+    if (count > DYNAMIC_KEYMAP_KEY_COUNT - index) count = DYNAMIC_KEYMAP_KEY_COUNT - index;
+    uint8_t buffer[DYNAMIC_KEYMAP_BULK_CHUNK * 2];
+    while (count > 0) {
+        uint16_t chunk = count < DYNAMIC_KEYMAP_BULK_CHUNK ? count : DYNAMIC_KEYMAP_BULK_CHUNK;
+        for (uint16_t i = 0; i < chunk; i++) {
+            buffer[i * 2]     = keycodes[i] >> 8;
+            buffer[i * 2 + 1] = keycodes[i] & 0xFF;
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+            dynamic_keymap_cache[index + i] = keycodes[i];
+#endif
+        }
+        eeprom_update_block(buffer, (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + index * 2), chunk * 2);
+        index += chunk;
+        keycodes += chunk;
+        count -= chunk;
+    }
+    resolved_layer_cache_invalidate();
 }
 
 uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column) {
@@ -407,6 +545,22 @@ uint16_t keycode_at_encodermap_location(uint8_t layer_num, uint8_t encoder_idx,
 }
 #endif // ENCODER_MAP_ENABLE
 
+#define DYNAMIC_KEYMAP_MACRO_NONE 0xFFFF
+
+// Offset of each macro in the buffer, DYNAMIC_KEYMAP_MACRO_NONE for those that don't exist
+static uint16_t macro_index[DYNAMIC_KEYMAP_MACRO_COUNT];
+static bool     macro_index_valid = false;
+// Offset of the next action of the macro being played
+static uint16_t macro_offset = DYNAMIC_KEYMAP_MACRO_NONE;
+
+#ifdef DEFERRED_EXEC_ENABLE
+static deferred_token macro_token = INVALID_DEFERRED_TOKEN;
+static uint8_t        macro_queue[DYNAMIC_KEYMAP_MACRO_QUEUE_SIZE];
+static uint8_t        macro_queue_head  = 0;
+static uint8_t        macro_queue_count = 0;
+static uint16_t       macro_held_keys[DYNAMIC_KEYMAP_MACRO_HELD_KEYS];
+#endif
+
 uint8_t dynamic_keymap_macro_get_count(void) {
     return DYNAMIC_KEYMAP_MACRO_COUNT;
 }
@@ -416,7 +570,7 @@ uint16_t dynamic_keymap_macro_get_buffer_size(void) {
 }
 
 void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   source = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
+    void *   source = (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
     uint8_t *target = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
@@ -430,7 +584,10 @@ void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *da
 }
 
 void dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   target = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
+    dynamic_keymap_macro_cancel();
+    macro_index_valid = false;
+
+    void *   target = (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
     uint8_t *source = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
@@ -442,6 +599,9 @@ void dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t *da
 }
 
 void dynamic_keymap_macro_reset(void) {
+    dynamic_keymap_macro_cancel();
+    macro_index_valid = false;
+
     void *p   = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR);
     void *end = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE);
     while (p != end) {
@@ -450,6 +610,32 @@ void dynamic_keymap_macro_reset(void) {
     }
 }
 
+// Finds the start of every macro in one pass over the buffer, rather than once per macro sent.
+static void dynamic_keymap_macro_rebuild_index(void) {
+    // Check the last byte of the buffer.
+    // If it's not zero, then we are in the middle
+    // of buffer writing, possibly an aborted buffer
+    // write. So no macro can be sent.
+    void *p            = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR);
+    bool  buffer_valid = eeprom_read_byte(p + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - 1) == 0;
+
+    uint8_t id = 0;
+    if (buffer_valid) {
+        macro_index[id++] = 0;
+        // Macro N starts after the Nth null. If there are not DYNAMIC_KEYMAP_MACRO_COUNT
+        // nulls in the buffer, the remaining macros don't exist.
+        for (uint16_t offset = 0; offset < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - 1 && id < DYNAMIC_KEYMAP_MACRO_COUNT; offset++) {
+            if (eeprom_read_byte(p + offset) == 0) {
+                macro_index[id++] = offset + 1;
+            }
+        }
+    }
+    while (id < DYNAMIC_KEYMAP_MACRO_COUNT) {
+        macro_index[id++] = DYNAMIC_KEYMAP_MACRO_NONE;
+    }
+    macro_index_valid = true;
+}
+
 static uint16_t decode_keycode(uint16_t kc) {
     /* map 0xFF01 => 0x0100; 0xFF02 => 0x0200, etc */
     if (kc > 0xFF00)
@@ -457,94 +643,183 @@ static uint16_t decode_keycode(uint16_t kc) {
     return kc;
 }
 
+#ifdef DEFERRED_EXEC_ENABLE
+// Remembers the keys a macro holds down, so that they can be released when it is cancelled
+static void macro_track_key(uint16_t keycode, bool pressed) {
+    for (uint8_t i = 0; i < DYNAMIC_KEYMAP_MACRO_HELD_KEYS; i++) {
+        if (pressed ? macro_held_keys[i] == KC_NO : macro_held_keys[i] == keycode) {
+            macro_held_keys[i] = pressed ? keycode : KC_NO;
+            return;
+        }
+    }
+}
+#else
+#    define macro_track_key(keycode, pressed)
+#endif
+
+static uint8_t macro_read_byte(void) {
+    return eeprom_read_byte((void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + macro_offset++));
+}
+
+// Plays the next action of the current macro, then returns how long to wait before the next one.
+// Stops playback on reaching the null terminator; every read stops at a null, and the buffer
+// is known to end with one, so this cannot go past the end of the buffer.
+static uint16_t dynamic_keymap_macro_step(void) {
+    uint8_t c = macro_read_byte();
+    if (c == 0) {
+        macro_offset = DYNAMIC_KEYMAP_MACRO_NONE;
+        return 0;
+    }
+    if (c != SS_QMK_PREFIX) {
+        // If the char wasn't magic, just send it
+        send_char(c);
+        return DYNAMIC_KEYMAP_MACRO_DELAY;
+    }
+
+    // If the char is magic, process it as indicated by the next character
+    // (tap, down, up, delay)
+    uint8_t code = macro_read_byte();
+    // Extended keycodes and delays take two bytes, the others one
+    bool    wide = code == VIAL_MACRO_EXT_TAP || code == VIAL_MACRO_EXT_DOWN || code == VIAL_MACRO_EXT_UP || code == SS_DELAY_CODE;
+    if (!wide && code != SS_TAP_CODE && code != SS_DOWN_CODE && code != SS_UP_CODE) {
+        if (code == 0) {
+            macro_offset = DYNAMIC_KEYMAP_MACRO_NONE;
+        }
+        return 0;
+    }
+    uint8_t d0 = macro_read_byte();
+    if (d0 == 0) {
+        macro_offset = DYNAMIC_KEYMAP_MACRO_NONE;
+        return 0;
+    }
+    if (code == SS_TAP_CODE) {
+        tap_code(d0);
+    } else if (code == SS_DOWN_CODE) {
+        register_code(d0);
+        macro_track_key(d0, true);
+    } else if (code == SS_UP_CODE) {
+        unregister_code(d0);
+        macro_track_key(d0, false);
+    } else if (wide) {
+        uint8_t d1 = macro_read_byte();
+        if (d1 == 0) {
+            macro_offset = DYNAMIC_KEYMAP_MACRO_NONE;
+            return 0;
+        }
+        if (code == SS_DELAY_CODE) {
+            // we cannot use 0 for these, need to subtract 1 and use 255 instead of 256 for delay calculation
+            return (d0 - 1) + (d1 - 1) * 255;
+        }
+        uint16_t kc = decode_keycode(d0 | (d1 << 8));
+        switch (code) {
+        case VIAL_MACRO_EXT_TAP:
+            vial_keycode_tap(kc);
+            break;
+        case VIAL_MACRO_EXT_DOWN:
+            vial_keycode_down(kc);
+            macro_track_key(kc, true);
+            break;
+        case VIAL_MACRO_EXT_UP:
+            vial_keycode_up(kc);
+            macro_track_key(kc, false);
+            break;
+        }
+    }
+    return 0;
+}
+
+static bool dynamic_keymap_macro_start(uint8_t id) {
+    if (id >= DYNAMIC_KEYMAP_MACRO_COUNT) {
+        return false;
+    }
+    if (!macro_index_valid) {
+        dynamic_keymap_macro_rebuild_index();
+    }
+    macro_offset = macro_index[id];
+    return macro_offset != DYNAMIC_KEYMAP_MACRO_NONE;
+}
+
+#ifdef DEFERRED_EXEC_ENABLE
+// Plays one action of the current macro every time it runs, at least a millisecond apart so that
+// the matrix keeps being scanned, moving on to the next queued macro when the current one ends.
+static uint32_t dynamic_keymap_macro_callback(uint32_t trigger_time, void *cb_arg) {
+    while (macro_offset == DYNAMIC_KEYMAP_MACRO_NONE) {
+        if (macro_queue_count == 0) {
+            macro_token = INVALID_DEFERRED_TOKEN;
+            return 0;
+        }
+        uint8_t id       = macro_queue[macro_queue_head];
+        macro_queue_head = (macro_queue_head + 1) % DYNAMIC_KEYMAP_MACRO_QUEUE_SIZE;
+        macro_queue_count--;
+        dynamic_keymap_macro_start(id);
+    }
+
+    uint16_t delay = dynamic_keymap_macro_step();
+    return delay ? delay : 1;
+}
+
+bool dynamic_keymap_macro_is_playing(void) {
+    return macro_offset != DYNAMIC_KEYMAP_MACRO_NONE || macro_token != INVALID_DEFERRED_TOKEN;
+}
+
+void dynamic_keymap_macro_cancel(void) {
+    if (macro_token != INVALID_DEFERRED_TOKEN) {
+        cancel_deferred_exec(macro_token);
+        macro_token = INVALID_DEFERRED_TOKEN;
+    }
+    macro_offset      = DYNAMIC_KEYMAP_MACRO_NONE;
+    macro_queue_count = 0;
+    for (uint8_t i = 0; i < DYNAMIC_KEYMAP_MACRO_HELD_KEYS; i++) {
+        if (macro_held_keys[i] != KC_NO) {
+            vial_keycode_up(macro_held_keys[i]);
+            macro_held_keys[i] = KC_NO;
+        }
+    }
+}
+
 void dynamic_keymap_macro_send(uint8_t id) {
     if (id >= DYNAMIC_KEYMAP_MACRO_COUNT) {
         return;
     }
 
-    // Check the last byte of the buffer.
-    // If it's not zero, then we are in the middle
-    // of buffer writing, possibly an aborted buffer
-    // write. So do nothing.
-    void *p = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - 1);
-    if (eeprom_read_byte(p) != 0) {
+    // Macros sent while another one plays are queued behind it, so that they still play in order
+    if (dynamic_keymap_macro_is_playing()) {
+        if (macro_queue_count < DYNAMIC_KEYMAP_MACRO_QUEUE_SIZE) {
+            macro_queue[(macro_queue_head + macro_queue_count) % DYNAMIC_KEYMAP_MACRO_QUEUE_SIZE] = id;
+            macro_queue_count++;
+        }
         return;
     }
 
-    // Skip N null characters
-    // p will then point to the Nth macro
-    p         = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR);
-    void *end = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE);
-    while (id > 0) {
-        // If we are past the end of the buffer, then the buffer
-        // contents are garbage, i.e. there were not DYNAMIC_KEYMAP_MACRO_COUNT
-        // nulls in the buffer.
-        if (p == end) {
-            return;
-        }
-        if (eeprom_read_byte(p) == 0) {
-            --id;
+    if (dynamic_keymap_macro_start(id)) {
+        // Play the first action right away, the rest from the deferred executor
+        uint32_t delay = dynamic_keymap_macro_callback(0, NULL);
+        macro_token    = defer_exec(delay, dynamic_keymap_macro_callback, NULL);
+        if (macro_token == INVALID_DEFERRED_TOKEN) {
+            // No executor available, finish playing the blocking way
+            while (delay) {
+                wait_ms(delay);
+                delay = dynamic_keymap_macro_callback(0, NULL);
+            }
         }
-        ++p;
     }
+}
+#else
+bool dynamic_keymap_macro_is_playing(void) {
+    return macro_offset != DYNAMIC_KEYMAP_MACRO_NONE;
+}
 
-    // Send the macro string one or three chars at a time
-    // by making temporary 1 or 3 char strings
-    char data[4] = {0, 0, 0, 0};
-    // We already checked there was a null at the end of
-    // the buffer, so this cannot go past the end
-    while (1) {
-        data[0] = eeprom_read_byte(p++);
-        data[1] = 0;
-        // Stop at the null terminator of this macro string
-        if (data[0] == 0) {
-            break;
-        }
-        if (data[0] == SS_QMK_PREFIX) {
-            // If the char is magic, process it as indicated by the next character
-            // (tap, down, up, delay)
-            data[1] = eeprom_read_byte(p++);
-            if (data[1] == 0)
-                break;
-            if (data[1] == SS_TAP_CODE || data[1] == SS_DOWN_CODE || data[1] == SS_UP_CODE) {
-                // For tap, down, up, just stuff it into the array and send_string it
-                data[2] = eeprom_read_byte(p++);
-                if (data[2] != 0)
-                    send_string(data);
-            } else if (data[1] == VIAL_MACRO_EXT_TAP || data[1] == VIAL_MACRO_EXT_DOWN || data[1] == VIAL_MACRO_EXT_UP) {
-                data[2] = eeprom_read_byte(p++);
-                if (data[2] != 0) {
-                    data[3] = eeprom_read_byte(p++);
-                    if (data[3] != 0) {
-                        uint16_t kc;
-                        memcpy(&kc, &data[2], sizeof(kc));
-                        kc = decode_keycode(kc);
-                        switch (data[1]) {
-                        case VIAL_MACRO_EXT_TAP:
-                            vial_keycode_tap(kc);
-                            break;
-                        case VIAL_MACRO_EXT_DOWN:
-                            vial_keycode_down(kc);
-                            break;
-                        case VIAL_MACRO_EXT_UP:
-                            vial_keycode_up(kc);
-                            break;
-                        }
-                    }
-                }
-            } else if (data[1] == SS_DELAY_CODE) {
-                // For delay, decode the delay and wait_ms for that amount
-                uint8_t d0 = eeprom_read_byte(p++);
-                uint8_t d1 = eeprom_read_byte(p++);
-                if (d0 == 0 || d1 == 0)
-                    break;
-                // we cannot use 0 for these, need to subtract 1 and use 255 instead of 256 for delay calculation
-                int ms = (d0 - 1) + (d1 - 1) * 255;
-                while (ms--) wait_ms(1);
-            }
-        } else {
-            // If the char wasn't magic, just send it
-            send_string_with_delay(data, DYNAMIC_KEYMAP_MACRO_DELAY);
+void dynamic_keymap_macro_cancel(void) {}
+
+void dynamic_keymap_macro_send(uint8_t id) {
+    // A macro can send another one, which then plays in full before the rest of the first
+    uint16_t outer_offset = macro_offset;
+    if (dynamic_keymap_macro_start(id)) {
+        while (macro_offset != DYNAMIC_KEYMAP_MACRO_NONE) {
+            uint16_t ms = dynamic_keymap_macro_step();
+            while (ms--) wait_ms(1);
         }
     }
+    macro_offset = outer_offset;
 }
+#endif
@@ -30,6 +30,9 @@
 #    define DYNAMIC_KEYMAP_MACRO_COUNT 16
 #endif
 
+// Loads the RAM copy of the keymap when DYNAMIC_KEYMAP_RAM_CACHE is defined, no-op otherwise.
+// Must be called once the EEPROM contents are known to be valid.
+void     dynamic_keymap_init(void);
 uint8_t  dynamic_keymap_get_layer_count(void);
 void *   dynamic_keymap_key_to_eeprom_address(uint8_t layer, uint8_t row, uint8_t column);
 uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column);
@@ -66,6 +69,12 @@ void     dynamic_keymap_reset(void);
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data);
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data);
 
+// These get/set host-endian keycodes by linear key index (layer * MATRIX_ROWS * MATRIX_COLS + row * MATRIX_COLS + column),
+// moving the EEPROM data in blocks. Out of range entries are ignored.
+uint16_t dynamic_keymap_get_key_count(void);
+void     dynamic_keymap_get_keycodes(uint16_t index, uint16_t count, uint16_t *keycodes);
+void     dynamic_keymap_set_keycodes(uint16_t index, uint16_t count, const uint16_t *keycodes);
+
 // This overrides the one in quantum/keymap_common.c
 // uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key);
 
@@ -95,4 +104,10 @@ void     dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t
 void     dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t *data);
 void     dynamic_keymap_macro_reset(void);
 
+// With DEFERRED_EXEC_ENABLE, macros play in the background from a deferred executor while keys
+// keep being processed, and macros sent during playback are queued behind the current one.
+// Otherwise dynamic_keymap_macro_send() only returns once the macro has been played.
 void dynamic_keymap_macro_send(uint8_t id);
+bool dynamic_keymap_macro_is_playing(void);
+// Stops the current macro, drops the queued ones and releases the keys the macro held down
+void dynamic_keymap_macro_cancel(void);
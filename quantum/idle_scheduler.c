@@ -0,0 +1,93 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "idle_scheduler.h"
+#include "quantum.h"
+
+#if defined(PROTOCOL_CHIBIOS)
+#    include <ch.h>
+#elif defined(__AVR__)
+#    include <avr/interrupt.h>
+#    include <avr/sleep.h>
+#endif
+
+static inline uint32_t earliest(uint32_t a, uint32_t b) {
+    return a < b ? a : b;
+}
+
+__attribute__((weak)) uint32_t idle_scheduler_next_deadline_user(void) {
+    return IDLE_SCHEDULER_NO_DEADLINE;
+}
+
+__attribute__((weak)) uint32_t idle_scheduler_next_deadline_kb(void) {
+    return idle_scheduler_next_deadline_user();
+}
+
+__attribute__((weak)) void idle_scheduler_sleep(uint32_t ms) {
+#if defined(PROTOCOL_CHIBIOS)
+    // Hands the core to the idle thread, which waits for an interrupt
+    chThdSleepMilliseconds(ms);
+#elif defined(__AVR__)
+    // Idle mode keeps the timers and USB running, so the millisecond tick or any USB event wakes the core
+    uint32_t start = timer_read32();
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    while (timer_elapsed32(start) < ms) {
+        sleep_enable();
+        sei();
+        sleep_cpu();
+        sleep_disable();
+    }
+#else
+    // Without a way to idle the core, sleeping would only be a busy-wait that delays the next scan
+    (void)ms;
+#endif
+}
+
+/* Tapping and one-shot timeouts are only acted upon by tick events, everything else polls from its own task */
+static uint32_t idle_scheduler_tick_deadline(void) {
+    uint32_t deadline = IDLE_SCHEDULER_NO_DEADLINE;
+#ifndef NO_ACTION_TAPPING
+    deadline = earliest(deadline, action_tapping_next_deadline());
+#endif
+#ifndef NO_ACTION_ONESHOT
+    deadline = earliest(deadline, oneshot_next_deadline());
+#endif
+    return deadline;
+}
+
+uint32_t idle_scheduler_next_deadline(void) {
+    uint32_t deadline = idle_scheduler_tick_deadline();
+#if defined(COMBO_ENABLE) && !defined(COMBO_NO_TIMER)
+    deadline = earliest(deadline, combo_next_deadline());
+#endif
+#ifdef DEFERRED_EXEC_ENABLE
+    deadline = earliest(deadline, deferred_exec_next_deadline());
+#endif
+#ifdef RGB_MATRIX_ENABLE
+    deadline = earliest(deadline, rgb_matrix_next_deadline());
+#endif
+#ifdef OLED_ENABLE
+    deadline = earliest(deadline, oled_next_deadline());
+#endif
+#if defined(SEND_STRING_ENABLE) && defined(SEND_STRING_ASYNC_ENABLE)
+    deadline = earliest(deadline, send_string_async_next_deadline());
+#endif
+    deadline = earliest(deadline, idle_scheduler_next_deadline_kb());
+    return deadline;
+}
+
+bool idle_scheduler_tick_due(void) {
+    return idle_scheduler_tick_deadline() == 0;
+}
+
+void idle_scheduler_task(bool activity_has_occurred) {
+    // Keep looping flat out while keys, encoders or the pointing device are moving
+    if (activity_has_occurred) {
+        return;
+    }
+
+    uint32_t deadline = idle_scheduler_next_deadline();
+    if (deadline > 0) {
+        idle_scheduler_sleep(earliest(deadline, IDLE_SCHEDULER_MAX_SLEEP));
+    }
+}
@@ -0,0 +1,44 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+/*
+    Deadline-driven idling of the main loop.
+
+    Every subsystem with pending timed work reports how many milliseconds remain until it
+    next needs to run (0 when it is due now, IDLE_SCHEDULER_NO_DEADLINE when it has nothing
+    pending). At the end of keyboard_task(), when there was no input activity, the loop sleeps
+    until the earliest of those deadlines, bounded by IDLE_SCHEDULER_MAX_SLEEP so that key
+    presses are still picked up in time. Tick events are likewise only generated once a
+    tapping or one-shot deadline has actually been reached.
+
+    Deadline sources:
+        - the tapping term of the current tap-hold key
+        - one-shot mod/layer timeouts
+        - the combo term
+        - deferred executors
+        - the RGB Matrix frame timer
+        - the OLED update interval and timeouts
+        - queued send_string_async() keystrokes
+        - idle_scheduler_next_deadline_kb()/_user() for keyboard and keymap code
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define IDLE_SCHEDULER_NO_DEADLINE UINT32_MAX
+
+/* Upper bound on a single sleep -- the matrix is not scanned while sleeping, so this is added to the worst-case input latency */
+#ifndef IDLE_SCHEDULER_MAX_SLEEP
+#    define IDLE_SCHEDULER_MAX_SLEEP 1
+#endif
+
+uint32_t idle_scheduler_next_deadline(void);
+bool     idle_scheduler_tick_due(void);
+void     idle_scheduler_task(bool activity_has_occurred);
+
+uint32_t idle_scheduler_next_deadline_kb(void);
+uint32_t idle_scheduler_next_deadline_user(void);
+
+/* Platform hook. Sleeps the thread on ChibiOS and enters idle sleep mode on AVR; elsewhere it does nothing */
+void idle_scheduler_sleep(uint32_t ms);
@@ -33,6 +33,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "sendchar.h"
 #include "eeconfig.h"
 #include "action_layer.h"
+#include "scan_profile.h"
 #ifdef AUDIO_ENABLE
 #    include "audio.h"
 #endif
@@ -102,6 +103,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef VIA_ENABLE
 #    include "via.h"
 #endif
+#ifdef DYNAMIC_KEYMAP_ENABLE
+#    include "dynamic_keymap.h"
+#endif
 #ifdef DIP_SWITCH_ENABLE
 #    include "dip_switch.h"
 #endif
@@ -114,6 +118,12 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef VIAL_ENABLE
 #   include "vial.h"
 #endif
+#ifdef IDLE_SCHEDULER_ENABLE
+#    include "idle_scheduler.h"
+#endif
+#if defined(SEND_STRING_ENABLE) && defined(SEND_STRING_ASYNC_ENABLE)
+#    include "send_string.h"
+#endif
 #if defined(CRC_ENABLE)
 #    include "crc.h"
 #endif
@@ -415,6 +425,9 @@ void keyboard_init(void) {
     sync_timer_init();
 #ifdef VIA_ENABLE
     via_init();
+#elif defined(DYNAMIC_KEYMAP_ENABLE)
+    // via_init() loads the keymap cache, builds without VIA do it here
+    dynamic_keymap_init();
 #endif
 #ifdef SPLIT_KEYBOARD
     split_pre_init();
@@ -498,6 +511,12 @@ void switch_events(uint8_t row, uint8_t col, bool pressed) {
  * internal QMK state machine.
  */
 static inline void generate_tick_event(void) {
+#ifdef IDLE_SCHEDULER_ENABLE
+    // Tick events only exist to time out tapping and one-shot keys, skip them until one of those is due
+    if (!idle_scheduler_tick_due()) {
+        return;
+    }
+#endif
     static uint16_t last_tick = 0;
     const uint16_t  now       = timer_read();
     if (TIMER_DIFF_16(now, last_tick) != 0) {
@@ -645,27 +664,38 @@ void quantum_task(void) {
 
 /** \brief Main task that is repeatedly called as fast as possible. */
 void keyboard_task(void) {
+    SCAN_PROFILE_BEGIN(SCAN_PROFILE_KEYBOARD_TASK);
     __attribute__((unused)) bool activity_has_occurred = false;
+    SCAN_PROFILE_BEGIN(SCAN_PROFILE_MATRIX_TASK);
     if (matrix_task()) {
         last_matrix_activity_trigger();
         activity_has_occurred = true;
     }
+    SCAN_PROFILE_END(SCAN_PROFILE_MATRIX_TASK);
 
+    SCAN_PROFILE_BEGIN(SCAN_PROFILE_QUANTUM_TASK);
     quantum_task();
+    SCAN_PROFILE_END(SCAN_PROFILE_QUANTUM_TASK);
 
 #if defined(SPLIT_WATCHDOG_ENABLE)
     split_watchdog_task();
 #endif
 
 #if defined(RGBLIGHT_ENABLE)
+    SCAN_PROFILE_BEGIN(SCAN_PROFILE_RGBLIGHT_TASK);
     rgblight_task();
+    SCAN_PROFILE_END(SCAN_PROFILE_RGBLIGHT_TASK);
 #endif
 
 #ifdef LED_MATRIX_ENABLE
+    SCAN_PROFILE_BEGIN(SCAN_PROFILE_LED_MATRIX_TASK);
     led_matrix_task();
+    SCAN_PROFILE_END(SCAN_PROFILE_LED_MATRIX_TASK);
 #endif
 #ifdef RGB_MATRIX_ENABLE
+    SCAN_PROFILE_BEGIN(SCAN_PROFILE_RGB_MATRIX_TASK);
     rgb_matrix_task();
+    SCAN_PROFILE_END(SCAN_PROFILE_RGB_MATRIX_TASK);
 #endif
 
 #if defined(BACKLIGHT_ENABLE)
@@ -675,21 +705,27 @@ void keyboard_task(void) {
 #endif
 
 #ifdef ENCODER_ENABLE
+    SCAN_PROFILE_BEGIN(SCAN_PROFILE_ENCODER_READ);
     if (encoder_read()) {
         last_encoder_activity_trigger();
         activity_has_occurred = true;
     }
+    SCAN_PROFILE_END(SCAN_PROFILE_ENCODER_READ);
 #endif
 
 #ifdef POINTING_DEVICE_ENABLE
+    SCAN_PROFILE_BEGIN(SCAN_PROFILE_POINTING_DEVICE_TASK);
     if (pointing_device_task()) {
         last_pointing_device_activity_trigger();
         activity_has_occurred = true;
     }
+    SCAN_PROFILE_END(SCAN_PROFILE_POINTING_DEVICE_TASK);
 #endif
 
 #ifdef OLED_ENABLE
+    SCAN_PROFILE_BEGIN(SCAN_PROFILE_OLED_TASK);
     oled_task();
+    SCAN_PROFILE_END(SCAN_PROFILE_OLED_TASK);
 #    if OLED_TIMEOUT > 0
     // Wake up oled if user is using those fabulous keys or spinning those encoders!
     if (activity_has_occurred) oled_on();
@@ -729,5 +765,19 @@ void keyboard_task(void) {
     haptic_task();
 #endif
 
+#ifdef VIAL_ENABLE
+    vial_task();
+#endif
+
+#if defined(SEND_STRING_ENABLE) && defined(SEND_STRING_ASYNC_ENABLE)
+    send_string_task();
+#endif
+
     led_task();
+
+    SCAN_PROFILE_END(SCAN_PROFILE_KEYBOARD_TASK);
+
+#ifdef IDLE_SCHEDULER_ENABLE
+    idle_scheduler_task(activity_has_occurred);
+#endif
 }
@@ -16,6 +16,7 @@
 
 #include "process_combo.h"
 #include <stddef.h>
+#include <string.h>
 #include "process_auto_shift.h"
 #include "caps_word.h"
 #include "timer.h"
@@ -117,6 +118,16 @@ static queued_combo_t combo_buffer[COMBO_BUFFER_LENGTH];
 
 #define INCREMENT_MOD(i) i = (i + 1) % COMBO_BUFFER_LENGTH
 
+#ifdef COMBO_KEY_INDEX
+/* Inverted index of every combo key, sorted by keycode and then by combo index,
+ * so a key event only has to visit the combos that actually contain it. */
+static uint16_t combo_key_index_keycodes[COMBO_KEY_INDEX_SIZE];
+static uint16_t combo_key_index_combos[COMBO_KEY_INDEX_SIZE];
+static uint16_t combo_key_index_size  = 0;
+static bool     combo_key_index_valid = false;
+static bool     combo_key_index_overflow = false;
+#endif
+
 #ifndef EXTRA_SHORT_COMBOS
 /* flags are their own elements in combo_t struct. */
 #    define COMBO_ACTIVE(combo) (combo->active)
@@ -301,6 +312,60 @@ static inline void _find_key_index_and_count(const uint16_t *keys, uint16_t keyc
     }
 }
 
+#ifdef COMBO_KEY_INDEX
+static inline bool combo_key_index_less(uint16_t keycode_a, uint16_t combo_a, uint16_t keycode_b, uint16_t combo_b) {
+    return keycode_a < keycode_b || (keycode_a == keycode_b && combo_a < combo_b);
+}
+
+void combo_key_index_rebuild(void) {
+    combo_key_index_size     = 0;
+    combo_key_index_overflow = false;
+    combo_key_index_valid    = true;
+
+    for (uint16_t idx = 0; idx < combo_count(); ++idx) {
+        const uint16_t *keys = combo_get(idx)->keys;
+        uint16_t        key;
+        for (uint8_t i = 0; (key = pgm_read_word(&keys[i])) != COMBO_END; ++i) {
+            if (combo_key_index_size == COMBO_KEY_INDEX_SIZE) {
+                combo_key_index_overflow = true;
+                return;
+            }
+
+            /* insertion sort -- entries arrive in combo order, so equal keycodes stay in combo order */
+            uint16_t pos = combo_key_index_size++;
+            while (pos > 0 && combo_key_index_less(key, idx, combo_key_index_keycodes[pos - 1], combo_key_index_combos[pos - 1])) {
+                combo_key_index_keycodes[pos] = combo_key_index_keycodes[pos - 1];
+                combo_key_index_combos[pos]   = combo_key_index_combos[pos - 1];
+                --pos;
+            }
+            if (pos > 0 && combo_key_index_keycodes[pos - 1] == key && combo_key_index_combos[pos - 1] == idx) {
+                /* same key listed twice in one combo, it only needs to be visited once */
+                memmove(&combo_key_index_keycodes[pos], &combo_key_index_keycodes[pos + 1], (combo_key_index_size - pos - 1) * sizeof(uint16_t));
+                memmove(&combo_key_index_combos[pos], &combo_key_index_combos[pos + 1], (combo_key_index_size - pos - 1) * sizeof(uint16_t));
+                --combo_key_index_size;
+                continue;
+            }
+            combo_key_index_keycodes[pos] = key;
+            combo_key_index_combos[pos]   = idx;
+        }
+    }
+}
+
+/* Returns the position of the first entry for keycode, or combo_key_index_size if there is none */
+static uint16_t combo_key_index_find(uint16_t keycode) {
+    uint16_t low = 0, high = combo_key_index_size;
+    while (low < high) {
+        uint16_t mid = low + (high - low) / 2;
+        if (combo_key_index_keycodes[mid] < keycode) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+#endif
+
 void drop_combo_from_buffer(uint16_t combo_index) {
     /* Mark a combo as processed from the buffer. If the buffer is in the
      * beginning of the buffer, drop it.  */
@@ -587,10 +652,24 @@ bool process_combo(uint16_t keycode, keyrecord_t *record) {
     }
 #endif
 
-    for (uint16_t idx = 0; idx < combo_count(); ++idx) {
-        combo_t *combo = combo_get(idx);
-        is_combo_key |= process_single_combo(combo, keycode, record, idx);
-        no_combo_keys_pressed = no_combo_keys_pressed && (NO_COMBO_KEYS_ARE_DOWN || COMBO_ACTIVE(combo) || COMBO_DISABLED(combo));
+#ifdef COMBO_KEY_INDEX
+    if (!combo_key_index_valid) {
+        combo_key_index_rebuild();
+    }
+    if (!combo_key_index_overflow) {
+        /* combos that don't contain keycode are never affected by process_single_combo */
+        for (uint16_t i = combo_key_index_find(keycode); i < combo_key_index_size && combo_key_index_keycodes[i] == keycode; ++i) {
+            uint16_t idx = combo_key_index_combos[i];
+            is_combo_key |= process_single_combo(combo_get(idx), keycode, record, idx);
+        }
+    } else
+#endif
+    {
+        for (uint16_t idx = 0; idx < combo_count(); ++idx) {
+            combo_t *combo = combo_get(idx);
+            is_combo_key |= process_single_combo(combo, keycode, record, idx);
+            no_combo_keys_pressed = no_combo_keys_pressed && (NO_COMBO_KEYS_ARE_DOWN || COMBO_ACTIVE(combo) || COMBO_DISABLED(combo));
+        }
     }
 
     if (record->event.pressed && is_combo_key) {
@@ -648,6 +727,17 @@ void combo_task(void) {
 #endif
 }
 
+#ifndef COMBO_NO_TIMER
+uint32_t combo_next_deadline(void) {
+    if (!b_combo_enable || !timer) {
+        return UINT32_MAX;
+    }
+    // combo_task() fires once the elapsed time exceeds the longest term
+    uint16_t elapsed = timer_elapsed(timer);
+    return elapsed <= longest_term ? (uint32_t)longest_term - elapsed + 1 : 0;
+}
+#endif
+
 void combo_enable(void) {
     b_combo_enable = true;
 }
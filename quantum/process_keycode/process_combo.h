@@ -39,6 +39,18 @@
 #    define COMBO_BUFFER_LENGTH 4
 #endif
 
+#ifdef COMBO_KEY_INDEX
+/* Number of (keycode, combo) pairs the inverted key index can hold.
+   If the combos contain more keys in total, process_combo() falls back to checking every combo. */
+#    ifndef COMBO_KEY_INDEX_SIZE
+#        ifdef VIAL_COMBO_ENTRIES
+#            define COMBO_KEY_INDEX_SIZE (VIAL_COMBO_ENTRIES * 4)
+#        else
+#            define COMBO_KEY_INDEX_SIZE 128
+#        endif
+#    endif
+#endif
+
 typedef struct combo_t {
     const uint16_t *keys;
     uint16_t        keycode;
@@ -75,8 +87,15 @@ typedef struct combo_t {
 
 bool process_combo(uint16_t keycode, keyrecord_t *record);
 void combo_task(void);
+#ifndef COMBO_NO_TIMER
+uint32_t combo_next_deadline(void);
+#endif
 void process_combo_event(uint16_t combo_index, bool pressed);
 
+#ifdef COMBO_KEY_INDEX
+void combo_key_index_rebuild(void);
+#endif
+
 void combo_enable(void);
 void combo_disable(void);
 void combo_toggle(void);
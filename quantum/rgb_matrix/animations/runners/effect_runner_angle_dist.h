@@ -0,0 +1,19 @@
+#pragma once
+
+typedef HSV (*angle_dist_f)(HSV hsv, uint8_t angle, uint8_t dist, uint8_t time);
+
+bool effect_runner_angle_dist(effect_params_t* params, angle_dist_f effect_func) {
+    RGB_MATRIX_USE_LIMITS(led_min, led_max);
+
+    uint8_t time = scale16by8(g_rgb_timer, rgb_matrix_config.speed / 2);
+    RGB_MATRIX_HSV_MEMO(memo);
+    for (uint8_t i = led_min; i < led_max; i++) {
+        RGB_MATRIX_TEST_LED_FLAGS();
+        int16_t dx    = g_led_config.point[i].x - k_rgb_matrix_center.x;
+        int16_t dy    = g_led_config.point[i].y - k_rgb_matrix_center.y;
+        uint8_t angle = led_geometry_angle(i, dx, dy);
+        uint8_t dist  = led_geometry_dist(i, dx, dy);
+        rgb_matrix_set_color_hsv_memo(&memo, i, effect_func(rgb_matrix_config.hsv, angle, dist, time));
+    }
+    return rgb_matrix_check_finished_leds(led_max);
+}
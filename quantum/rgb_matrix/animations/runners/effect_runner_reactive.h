@@ -8,20 +8,21 @@ bool effect_runner_reactive(effect_params_t* params, reactive_f effect_func) {
     RGB_MATRIX_USE_LIMITS(led_min, led_max);
 
     uint16_t max_tick = 65535 / qadd8(rgb_matrix_config.speed, 1);
+    RGB_MATRIX_HSV_MEMO(memo);
     for (uint8_t i = led_min; i < led_max; i++) {
         RGB_MATRIX_TEST_LED_FLAGS();
         uint16_t tick = max_tick;
         // Reverse search to find most recent key hit
-        for (int8_t j = g_last_hit_tracker.count - 1; j >= 0; j--) {
-            if (g_last_hit_tracker.index[j] == i && g_last_hit_tracker.tick[j] < tick) {
-                tick = g_last_hit_tracker.tick[j];
+        for (int16_t j = g_last_hit_tracker.count - 1; j >= 0; j--) {
+            uint8_t slot = rgb_matrix_hit_slot(j);
+            if (g_last_hit_tracker.index[slot] == i && rgb_matrix_hit_tick(slot) < tick) {
+                tick = rgb_matrix_hit_tick(slot);
                 break;
             }
         }
 
         uint16_t offset = scale16by8(tick, qadd8(rgb_matrix_config.speed, 1));
-        RGB      rgb    = rgb_matrix_hsv_to_rgb(effect_func(rgb_matrix_config.hsv, offset));
-        rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
+        rgb_matrix_set_color_hsv_memo(&memo, i, effect_func(rgb_matrix_config.hsv, offset));
     }
     return rgb_matrix_check_finished_leds(led_max);
 }
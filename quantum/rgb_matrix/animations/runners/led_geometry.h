@@ -0,0 +1,18 @@
+#pragma once
+
+// Distance and angle of LED i from k_rgb_matrix_center, at offset dx, dy
+static inline uint8_t led_geometry_dist(uint8_t i, int16_t dx, int16_t dy) {
+#ifdef RGB_MATRIX_GEOMETRY_TABLE
+    return g_led_geometry[i].dist;
+#else
+    return sqrt16(dx * dx + dy * dy);
+#endif
+}
+
+static inline uint8_t led_geometry_angle(uint8_t i, int16_t dx, int16_t dy) {
+#ifdef RGB_MATRIX_GEOMETRY_TABLE
+    return g_led_geometry[i].angle;
+#else
+    return atan2_8(dy, dx);
+#endif
+}
@@ -4,15 +4,64 @@ RGB_MATRIX_EFFECT(VIALRGB_DIRECT)
 #    ifdef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
 
 extern HSV g_direct_mode_colors[RGB_MATRIX_LED_COUNT];
+#        ifdef VIALRGB_DIRECT_STREAM
+const uint16_t* vialrgb_direct_stream_frame(void);
+void            vialrgb_direct_stream_stop(void);
+#        endif
 
-bool VIALRGB_DIRECT(effect_params_t* params) {
-    RGB_MATRIX_USE_LIMITS(led_min, led_max);
+// Streamed colors are RGB565, expanded to 8 bits and limited to the maximum brightness
+static inline uint8_t vialrgb_stream_channel(uint8_t c) {
+#        if RGB_MATRIX_MAXIMUM_BRIGHTNESS < UINT8_MAX
+    return scale8(c, RGB_MATRIX_MAXIMUM_BRIGHTNESS);
+#        else
+    return c;
+#        endif
+}
 
+static void vialrgb_direct_render(const uint16_t* stream, uint8_t led_min, uint8_t led_max) {
     for (uint8_t i = led_min; i < led_max; i++) {
-        RGB rgb = rgb_matrix_hsv_to_rgb(g_direct_mode_colors[i]);
+        RGB rgb;
+        if (stream) {
+            uint16_t c = stream[i];
+            rgb.r      = vialrgb_stream_channel(((c >> 8) & 0xF8) | (c >> 13));
+            rgb.g      = vialrgb_stream_channel(((c >> 3) & 0xFC) | ((c >> 9) & 0x03));
+            rgb.b      = vialrgb_stream_channel(((c << 3) & 0xF8) | ((c >> 2) & 0x07));
+        } else {
+            rgb = rgb_matrix_hsv_to_rgb(g_direct_mode_colors[i]);
+        }
         rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
     }
-    return led_max < RGB_MATRIX_LED_COUNT;
+}
+
+bool VIALRGB_DIRECT(effect_params_t* params) {
+    RGB_MATRIX_USE_LIMITS(led_min, led_max);
+
+    // Picked once per frame, so a newly streamed frame never shows up halfway through
+    static const uint16_t* stream;
+#        ifdef VIALRGB_DIRECT_STREAM
+    if (params->init) {
+        // Selected again, so show the fastset colors until the host streams a new frame
+        vialrgb_direct_stream_stop();
+    }
+    if (params->iter == 0) {
+        stream = vialrgb_direct_stream_frame();
+    }
+#        endif
+
+    vialrgb_direct_render(stream, led_min, led_max);
+    bool rendering = rgb_matrix_check_finished_leds(led_max);
+#        if defined(RGB_MATRIX_SPLIT) && defined(SPLIT_RGB_MATRIX_COLORS_ENABLE)
+    // Only the master hears from the host, it renders the other half too and its colors are sent over
+    if (!rendering && is_keyboard_master()) {
+        const uint8_t k_rgb_matrix_split[2] = RGB_MATRIX_SPLIT;
+        if (is_keyboard_left()) {
+            vialrgb_direct_render(stream, k_rgb_matrix_split[0], RGB_MATRIX_LED_COUNT);
+        } else {
+            vialrgb_direct_render(stream, 0, k_rgb_matrix_split[0]);
+        }
+    }
+#        endif
+    return rendering;
 }
 #    endif
 #endif
@@ -39,6 +39,21 @@ __attribute__((weak)) RGB rgb_matrix_hsv_to_rgb(HSV hsv) {
     return hsv_to_rgb(hsv);
 }
 
+#ifdef RGB_MATRIX_GEOMETRY_TABLE
+led_geometry_t g_led_geometry[RGB_MATRIX_LED_COUNT];
+#endif
+
+void rgb_matrix_set_color_hsv_memo(rgb_matrix_hsv_memo_t *memo, uint8_t index, HSV hsv) {
+    // Neighbouring LEDs often end up the same colour, most of all the ones that are off, and the
+    // compare costs far less than the divide in hsv_to_rgb() on the MCUs that have no divider
+    if (!memo->valid || hsv.h != memo->hsv.h || hsv.s != memo->hsv.s || hsv.v != memo->hsv.v) {
+        memo->hsv   = hsv;
+        memo->rgb   = rgb_matrix_hsv_to_rgb(hsv);
+        memo->valid = true;
+    }
+    rgb_matrix_set_color(index, memo->rgb.r, memo->rgb.g, memo->rgb.b);
+}
+
 // Generic effect runners
 #include "rgb_matrix_runners.inc"
 
@@ -76,14 +91,33 @@ static uint8_t         rgb_last_enable   = UINT8_MAX;
 static uint8_t         rgb_last_effect   = UINT8_MAX;
 static effect_params_t rgb_effect_params = {0, LED_FLAG_ALL, false};
 static rgb_task_states rgb_task_state    = SYNCING;
+static volatile bool   rgb_flush_pending = false;
+static uint32_t        rgb_flush_start;
 #if RGB_MATRIX_TIMEOUT > 0
 static uint32_t rgb_anykey_timer;
 #endif // RGB_MATRIX_TIMEOUT > 0
+#ifdef RGB_MATRIX_RENDER_BUDGET_US
+static uint8_t  rgb_slice_min;
+static uint8_t  rgb_slice_max;
+static uint8_t  rgb_slice_size = RGB_MATRIX_LED_PROCESS_LIMIT;
+static uint16_t rgb_led_cost; // in 1/16 us
+static uint32_t rgb_frame_start;
+static uint32_t rgb_fps_window_start;
+static uint16_t rgb_fps_window_frames;
+static uint16_t rgb_fps;
+static uint32_t rgb_dropped_frames;
+#endif // RGB_MATRIX_RENDER_BUDGET_US
 
 // double buffers
 static uint32_t rgb_timer_buffer;
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-static last_hit_t last_hit_buffer;
+// hits recorded so far, g_last_hit_tracker only exposes those present when the frame started
+static uint8_t last_hit_head;
+static uint8_t last_hit_count;
+// hits that came in while a frame was rendering, they would overwrite slots it is reading
+static uint8_t  pending_hit_led[LED_HITS_PENDING];
+static uint32_t pending_hit_time[LED_HITS_PENDING];
+static uint8_t  pending_hit_count;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
 // split rgb matrix
@@ -91,6 +125,19 @@ static last_hit_t last_hit_buffer;
 const uint8_t k_rgb_matrix_split[2] = RGB_MATRIX_SPLIT;
 #endif
 
+#if defined(RGB_MATRIX_SPLIT) && defined(SPLIT_RGB_MATRIX_COLORS_ENABLE)
+// Colors of the other half's LEDs: set on the master by indicators and host-driven effects, received on the slave
+static uint8_t rgb_split_color[RGB_MATRIX_LED_COUNT][3];
+static uint8_t rgb_split_valid[(RGB_MATRIX_LED_COUNT + 7) / 8];
+// master only, LEDs set during the frame being rendered and LEDs changed since last sent
+static uint8_t rgb_split_written[(RGB_MATRIX_LED_COUNT + 7) / 8];
+static uint8_t rgb_split_dirty[(RGB_MATRIX_LED_COUNT + 7) / 8];
+static uint8_t rgb_split_dirty_index;
+static uint8_t rgb_split_refresh_index;
+// slave only, received colors not flushed yet
+static bool rgb_split_changed;
+#endif
+
 EECONFIG_DEBOUNCE_HELPER(rgb_matrix, EECONFIG_RGB_MATRIX, rgb_matrix_config);
 
 void eeconfig_update_rgb_matrix(void) {
@@ -146,12 +193,131 @@ void rgb_matrix_update_pwm_buffers(void) {
     rgb_matrix_driver.flush();
 }
 
+#if defined(RGB_MATRIX_SPLIT) && defined(SPLIT_RGB_MATRIX_COLORS_ENABLE)
+static inline bool rgb_split_bit(const uint8_t *bits, uint8_t index) {
+    return bits[index >> 3] & (1 << (index & 7));
+}
+
+static inline void rgb_split_set_bit(uint8_t *bits, uint8_t index, bool value) {
+    if (value) {
+        bits[index >> 3] |= (1 << (index & 7));
+    } else {
+        bits[index >> 3] &= ~(1 << (index & 7));
+    }
+}
+
+static inline bool rgb_split_is_remote(int index) {
+    if (index < 0 || index >= RGB_MATRIX_LED_COUNT) {
+        return false;
+    }
+    return is_keyboard_left() ? index >= k_rgb_matrix_split[0] : index < k_rgb_matrix_split[0];
+}
+
+static void rgb_split_capture(uint8_t index, uint8_t red, uint8_t green, uint8_t blue) {
+    uint8_t *color = rgb_split_color[index];
+    if (!rgb_split_bit(rgb_split_valid, index) || color[0] != red || color[1] != green || color[2] != blue) {
+        color[0] = red;
+        color[1] = green;
+        color[2] = blue;
+        rgb_split_set_bit(rgb_split_valid, index, true);
+        rgb_split_set_bit(rgb_split_dirty, index, true);
+    }
+    rgb_split_set_bit(rgb_split_written, index, true);
+}
+
+// Master, called once a frame is complete: LEDs nothing set during the frame go back to the other half's own effect
+static void rgb_split_end_frame(void) {
+    for (uint8_t i = 0; i < sizeof(rgb_split_valid); i++) {
+        uint8_t released = rgb_split_valid[i] & ~rgb_split_written[i];
+        rgb_split_valid[i] &= ~released;
+        rgb_split_dirty[i] |= released;
+        rgb_split_written[i] = 0;
+    }
+}
+
+// Slave, called before flushing: received colors replace whatever the local effect rendered
+static void rgb_split_apply(uint8_t effect) {
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        if (rgb_split_bit(rgb_split_valid, i)) {
+            rgb_matrix_driver.set_color(i, rgb_split_color[i][0], rgb_split_color[i][1], rgb_split_color[i][2]);
+        } else if (effect == RGB_MATRIX_NONE && rgb_split_changed) {
+            // Nothing else repaints released LEDs while off
+            rgb_matrix_driver.set_color(i, 0, 0, 0);
+        }
+    }
+    rgb_split_changed = false;
+}
+
+uint8_t rgb_matrix_split_colors_collect(rgb_matrix_split_color_t *colors, uint8_t max, bool refresh) {
+    uint8_t count = 0;
+    // Starts where the last sync stopped, so LEDs past the first few that change every frame still get their turn
+    for (uint8_t n = 0; n < RGB_MATRIX_LED_COUNT && count < max; n++) {
+        uint8_t i = rgb_split_dirty_index;
+        if (++rgb_split_dirty_index >= RGB_MATRIX_LED_COUNT) {
+            rgb_split_dirty_index = 0;
+        }
+        if (rgb_split_bit(rgb_split_dirty, i)) {
+            rgb_split_set_bit(rgb_split_dirty, i, false);
+            colors[count++] = (rgb_matrix_split_color_t){i, rgb_split_bit(rgb_split_valid, i), rgb_split_color[i][0], rgb_split_color[i][1], rgb_split_color[i][2]};
+        }
+    }
+
+    // Spare room goes to resending the other LEDs in turn, so a slave that restarted catches up
+    if (refresh) {
+        for (uint8_t n = 0; n < RGB_MATRIX_LED_COUNT && count < max; n++) {
+            uint8_t i = rgb_split_refresh_index;
+            if (++rgb_split_refresh_index >= RGB_MATRIX_LED_COUNT) {
+                rgb_split_refresh_index = 0;
+            }
+            if (rgb_split_is_remote(i) && !rgb_split_bit(rgb_split_dirty, i)) {
+                colors[count++] = (rgb_matrix_split_color_t){i, rgb_split_bit(rgb_split_valid, i), rgb_split_color[i][0], rgb_split_color[i][1], rgb_split_color[i][2]};
+            }
+        }
+    }
+    return count;
+}
+
+void rgb_matrix_split_colors_resend(const rgb_matrix_split_color_t *colors, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        rgb_split_set_bit(rgb_split_dirty, colors[i].index, true);
+    }
+}
+
+void rgb_matrix_split_colors_receive(const rgb_matrix_split_color_t *colors, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t index = colors[i].index;
+        if (index >= RGB_MATRIX_LED_COUNT) {
+            continue;
+        }
+        uint8_t *color = rgb_split_color[index];
+        if (rgb_split_bit(rgb_split_valid, index) != colors[i].valid || color[0] != colors[i].r || color[1] != colors[i].g || color[2] != colors[i].b) {
+            color[0] = colors[i].r;
+            color[1] = colors[i].g;
+            color[2] = colors[i].b;
+            rgb_split_set_bit(rgb_split_valid, index, colors[i].valid);
+            rgb_split_changed = true;
+        }
+    }
+}
+#endif
+
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+#if defined(RGB_MATRIX_SPLIT) && defined(SPLIT_RGB_MATRIX_COLORS_ENABLE)
+    // The other half's LEDs can't be driven from here, their colors are sent over
+    if (is_keyboard_master() && rgb_split_is_remote(index)) {
+        rgb_split_capture(index, red, green, blue);
+        return;
+    }
+#endif
     rgb_matrix_driver.set_color(index, red, green, blue);
 }
 
 void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
-#if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
+#if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT) && defined(SPLIT_RGB_MATRIX_COLORS_ENABLE)
+    // Fills, mostly clears, don't override the other half's colors, only LEDs set one by one are sent over
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++)
+        rgb_matrix_driver.set_color(i, red, green, blue);
+#elif defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
     for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++)
         rgb_matrix_set_color(i, red, green, blue);
 #else
@@ -159,6 +325,32 @@ void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
 #endif
 }
 
+#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+static void rgb_matrix_record_hit(uint8_t led, uint32_t time) {
+    // When full, the oldest hit makes room
+    uint16_t slot = last_hit_head + last_hit_count;
+    if (slot >= LED_HITS_TO_REMEMBER) {
+        slot -= LED_HITS_TO_REMEMBER;
+    }
+    if (last_hit_count < LED_HITS_TO_REMEMBER) {
+        last_hit_count++;
+    } else if (++last_hit_head == LED_HITS_TO_REMEMBER) {
+        last_hit_head = 0;
+    }
+    g_last_hit_tracker.x[slot]     = g_led_config.point[led].x;
+    g_last_hit_tracker.y[slot]     = g_led_config.point[led].y;
+    g_last_hit_tracker.index[slot] = led;
+    g_last_hit_tracker.time[slot]  = time;
+}
+
+static void rgb_matrix_commit_pending_hits(void) {
+    for (uint8_t i = 0; i < pending_hit_count; i++) {
+        rgb_matrix_record_hit(pending_hit_led[i], pending_hit_time[i]);
+    }
+    pending_hit_count = 0;
+}
+#endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+
 void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed) {
 #ifndef RGB_MATRIX_SPLIT
     if (!is_keyboard_master()) return;
@@ -180,21 +372,22 @@ void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed) {
         led_count = rgb_matrix_map_row_column_to_led(row, col, led);
     }
 
-    if (last_hit_buffer.count + led_count > LED_HITS_TO_REMEMBER) {
-        memcpy(&last_hit_buffer.x[0], &last_hit_buffer.x[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.y[0], &last_hit_buffer.y[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.tick[0], &last_hit_buffer.tick[led_count], (LED_HITS_TO_REMEMBER - led_count) * 2); // 16 bit
-        memcpy(&last_hit_buffer.index[0], &last_hit_buffer.index[led_count], LED_HITS_TO_REMEMBER - led_count);
-        last_hit_buffer.count = LED_HITS_TO_REMEMBER - led_count;
-    }
-
     for (uint8_t i = 0; i < led_count; i++) {
-        uint8_t index                = last_hit_buffer.count;
-        last_hit_buffer.x[index]     = g_led_config.point[led[i]].x;
-        last_hit_buffer.y[index]     = g_led_config.point[led[i]].y;
-        last_hit_buffer.index[index] = led[i];
-        last_hit_buffer.tick[index]  = 0;
-        last_hit_buffer.count++;
+        if (rgb_task_state != RENDERING) {
+            // Hits held back by the frame go first, to keep them in order
+            rgb_matrix_commit_pending_hits();
+            rgb_matrix_record_hit(led[i], rgb_timer_buffer);
+            continue;
+        }
+        // Held until the next frame starts, when full the oldest makes room
+        if (pending_hit_count == LED_HITS_PENDING) {
+            pending_hit_count--;
+            memmove(&pending_hit_led[0], &pending_hit_led[1], pending_hit_count);
+            memmove(&pending_hit_time[0], &pending_hit_time[1], pending_hit_count * sizeof(pending_hit_time[0]));
+        }
+        pending_hit_led[pending_hit_count]  = led[i];
+        pending_hit_time[pending_hit_count] = rgb_timer_buffer;
+        pending_hit_count++;
     }
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
@@ -246,9 +439,9 @@ static bool rgb_matrix_none(effect_params_t *params) {
 }
 
 static void rgb_task_timers(void) {
-#if defined(RGB_MATRIX_KEYREACTIVE_ENABLED) || RGB_MATRIX_TIMEOUT > 0
+#if RGB_MATRIX_TIMEOUT > 0
     uint32_t deltaTime = sync_timer_elapsed32(rgb_timer_buffer);
-#endif // defined(RGB_MATRIX_KEYREACTIVE_ENABLED) || RGB_MATRIX_TIMEOUT > 0
+#endif // RGB_MATRIX_TIMEOUT > 0
     rgb_timer_buffer = sync_timer_read32();
 
     // Update double buffer timers
@@ -258,15 +451,13 @@ static void rgb_task_timers(void) {
     }
 #endif // RGB_MATRIX_TIMEOUT > 0
 
-    // Update double buffer last hit timers
+    // Forget hits too old to be shown, they are in order so only the oldest need checking
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-    uint8_t count = last_hit_buffer.count;
-    for (uint8_t i = 0; i < count; ++i) {
-        if (UINT16_MAX - deltaTime < last_hit_buffer.tick[i]) {
-            last_hit_buffer.count--;
-            continue;
+    while (last_hit_count > 0 && (int32_t)(rgb_timer_buffer - g_last_hit_tracker.time[last_hit_head]) > UINT16_MAX) {
+        last_hit_count--;
+        if (++last_hit_head == LED_HITS_TO_REMEMBER) {
+            last_hit_head = 0;
         }
-        last_hit_buffer.tick[i] += deltaTime;
     }
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 }
@@ -277,14 +468,75 @@ static void rgb_task_sync(void) {
     if (sync_timer_elapsed32(g_rgb_timer) >= RGB_MATRIX_LED_FLUSH_LIMIT) rgb_task_state = STARTING;
 }
 
+#ifdef RGB_MATRIX_RENDER_BUDGET_US
+static void rgb_render_count_frame(void) {
+    uint32_t now = timer_read32();
+
+#    if RGB_MATRIX_LED_FLUSH_LIMIT > 0
+    // Frame periods that went by without a frame starting
+    uint32_t period = TIMER_DIFF_32(now, rgb_frame_start);
+    if (rgb_frame_start != 0 && period >= 2 * RGB_MATRIX_LED_FLUSH_LIMIT) {
+        rgb_dropped_frames += period / RGB_MATRIX_LED_FLUSH_LIMIT - 1;
+    }
+#    endif
+    rgb_frame_start = now;
+
+    rgb_fps_window_frames++;
+    uint32_t window = TIMER_DIFF_32(now, rgb_fps_window_start);
+    if (window >= 1000) {
+        rgb_fps               = (uint32_t)rgb_fps_window_frames * 1000 / window;
+        rgb_fps_window_frames = 0;
+        rgb_fps_window_start  = now;
+    }
+}
+
+static void rgb_render_governor_update(uint8_t leds, uint32_t elapsed_us) {
+    if (leds == 0) {
+        return;
+    }
+
+    // Per-LED cost, smoothed so that one slice that got interrupted does not collapse the slice size
+    uint32_t cost = (elapsed_us << 4) / leds;
+    if (cost > UINT16_MAX) {
+        cost = UINT16_MAX;
+    }
+    rgb_led_cost = ((uint32_t)rgb_led_cost * 3 + cost) / 4;
+
+    uint32_t size = rgb_led_cost ? ((uint32_t)RGB_MATRIX_RENDER_BUDGET_US << 4) / rgb_led_cost : RGB_MATRIX_LED_COUNT;
+    if (size < 1) {
+        size = 1;
+    } else if (size > RGB_MATRIX_LED_COUNT) {
+        size = RGB_MATRIX_LED_COUNT;
+    }
+    rgb_slice_size = size;
+}
+
+void rgb_matrix_get_render_stats(rgb_matrix_render_stats_t *stats) {
+    stats->fps            = rgb_fps;
+    stats->dropped_frames = rgb_dropped_frames;
+    stats->slice_leds     = rgb_slice_size;
+    stats->led_cost_us    = (rgb_led_cost + 8) >> 4;
+}
+#endif // RGB_MATRIX_RENDER_BUDGET_US
+
 static void rgb_task_start(void) {
     // reset iter
     rgb_effect_params.iter = 0;
+#ifdef RGB_MATRIX_RENDER_BUDGET_US
+    rgb_render_count_frame();
+#    if defined(RGB_MATRIX_SPLIT)
+    rgb_slice_max = is_keyboard_left() ? 0 : k_rgb_matrix_split[0];
+#    else
+    rgb_slice_max = 0;
+#    endif
+#endif // RGB_MATRIX_RENDER_BUDGET_US
 
     // update double buffers
     g_rgb_timer = rgb_timer_buffer;
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-    g_last_hit_tracker = last_hit_buffer;
+    rgb_matrix_commit_pending_hits();
+    g_last_hit_tracker.head  = last_hit_head;
+    g_last_hit_tracker.count = last_hit_count;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
     // next task
@@ -294,6 +546,11 @@ static void rgb_task_start(void) {
 static void rgb_task_render(uint8_t effect) {
     bool rendering         = false;
     rgb_effect_params.init = (effect != rgb_last_effect) || (rgb_matrix_config.enable != rgb_last_enable);
+#ifdef RGB_MATRIX_RENDER_BUDGET_US
+    // The slice picks up where the previous one ended, its size is whatever fits in the budget
+    rgb_slice_min = rgb_slice_max;
+    rgb_slice_max = rgb_slice_min + rgb_slice_size < RGB_MATRIX_LED_COUNT ? rgb_slice_min + rgb_slice_size : RGB_MATRIX_LED_COUNT;
+#endif // RGB_MATRIX_RENDER_BUDGET_US
     if (rgb_effect_params.flags != rgb_matrix_config.flags) {
         rgb_effect_params.flags = rgb_matrix_config.flags;
         rgb_matrix_set_color_all(0, 0, 0);
@@ -347,17 +604,50 @@ static void rgb_task_render(uint8_t effect) {
         if (!rgb_effect_params.init && effect == RGB_MATRIX_NONE) {
             // We only need to flush once if we are RGB_MATRIX_NONE
             rgb_task_state = SYNCING;
+#if defined(RGB_MATRIX_SPLIT) && defined(SPLIT_RGB_MATRIX_COLORS_ENABLE)
+            // unless the master sent over new colors
+            if (rgb_split_changed) rgb_task_state = FLUSHING;
+#endif
         }
     }
 }
 
+void rgb_matrix_flush_complete(void) {
+    rgb_flush_pending = false;
+}
+
+bool rgb_matrix_flush_in_progress(void) {
+    return rgb_flush_pending;
+}
+
 static void rgb_task_flush(uint8_t effect) {
+    if (rgb_matrix_driver.flush_async) {
+        // The previous frame is still being sent, this one was rendered meanwhile and waits its turn
+        if (rgb_flush_pending && sync_timer_elapsed32(rgb_flush_start) < RGB_MATRIX_FLUSH_ASYNC_TIMEOUT) {
+            return;
+        }
+    }
+
     // update last trackers after the first full render so we can init over several frames
     rgb_last_effect = effect;
     rgb_last_enable = rgb_matrix_config.enable;
 
+#if defined(RGB_MATRIX_SPLIT) && defined(SPLIT_RGB_MATRIX_COLORS_ENABLE)
+    if (is_keyboard_master()) {
+        rgb_split_end_frame();
+    } else {
+        rgb_split_apply(effect);
+    }
+#endif
+
     // update pwm buffers
-    rgb_matrix_update_pwm_buffers();
+    if (rgb_matrix_driver.flush_async) {
+        rgb_flush_pending = true;
+        rgb_flush_start   = sync_timer_read32();
+        rgb_matrix_driver.flush_async();
+    } else {
+        rgb_matrix_update_pwm_buffers();
+    }
 
     // next task
     rgb_task_state = SYNCING;
@@ -380,7 +670,10 @@ void rgb_matrix_task(void) {
         case STARTING:
             rgb_task_start();
             break;
-        case RENDERING:
+        case RENDERING: {
+#ifdef RGB_MATRIX_RENDER_BUDGET_US
+            uint32_t slice_start = timer_read_us();
+#endif // RGB_MATRIX_RENDER_BUDGET_US
             rgb_task_render(effect);
             if (effect) {
                 if (rgb_task_state == FLUSHING) { // ensure we only draw basic indicators once rendering is finished
@@ -388,7 +681,11 @@ void rgb_matrix_task(void) {
                 }
                 rgb_matrix_indicators_advanced(&rgb_effect_params);
             }
+#ifdef RGB_MATRIX_RENDER_BUDGET_US
+            rgb_render_governor_update(rgb_slice_max - rgb_slice_min, TIMER_DIFF_32(timer_read_us(), slice_start));
+#endif // RGB_MATRIX_RENDER_BUDGET_US
             break;
+        }
         case FLUSHING:
             rgb_task_flush(effect);
             break;
@@ -398,6 +695,15 @@ void rgb_matrix_task(void) {
     }
 }
 
+uint32_t rgb_matrix_next_deadline(void) {
+    // A frame is rendered and flushed over several consecutive task calls, only the wait for the next frame can be slept through
+    if (rgb_task_state != SYNCING) {
+        return 0;
+    }
+    uint32_t elapsed = sync_timer_elapsed32(g_rgb_timer);
+    return elapsed < RGB_MATRIX_LED_FLUSH_LIMIT ? RGB_MATRIX_LED_FLUSH_LIMIT - elapsed : 0;
+}
+
 void rgb_matrix_indicators(void) {
     rgb_matrix_indicators_kb();
 }
@@ -412,7 +718,16 @@ __attribute__((weak)) bool rgb_matrix_indicators_user(void) {
 
 struct rgb_matrix_limits_t rgb_matrix_get_limits(uint8_t iter) {
     struct rgb_matrix_limits_t limits = {0};
-#if defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < RGB_MATRIX_LED_COUNT
+#if defined(RGB_MATRIX_RENDER_BUDGET_US)
+    // Slices vary in size, so they can't be derived from iter, this is always the one being rendered
+    limits.led_min_index = rgb_slice_min;
+    limits.led_max_index = rgb_slice_max;
+#    if defined(RGB_MATRIX_SPLIT)
+    if (is_keyboard_left() && (limits.led_max_index > k_rgb_matrix_split[0])) limits.led_max_index = k_rgb_matrix_split[0];
+    if (!(is_keyboard_left()) && (limits.led_min_index < k_rgb_matrix_split[0])) limits.led_min_index = k_rgb_matrix_split[0];
+    if (limits.led_min_index > limits.led_max_index) limits.led_min_index = limits.led_max_index;
+#    endif
+#elif defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < RGB_MATRIX_LED_COUNT
 #    if defined(RGB_MATRIX_SPLIT)
     limits.led_min_index = RGB_MATRIX_LED_PROCESS_LIMIT * (iter);
     limits.led_max_index = limits.led_min_index + RGB_MATRIX_LED_PROCESS_LIMIT;
@@ -458,19 +773,28 @@ __attribute__((weak)) bool rgb_matrix_indicators_advanced_user(uint8_t led_min,
     return true;
 }
 
+void rgb_matrix_update_geometry(void) {
+#ifdef RGB_MATRIX_GEOMETRY_TABLE
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        int16_t dx              = g_led_config.point[i].x - k_rgb_matrix_center.x;
+        int16_t dy              = g_led_config.point[i].y - k_rgb_matrix_center.y;
+        g_led_geometry[i].dist  = sqrt16(dx * dx + dy * dy);
+        g_led_geometry[i].angle = atan2_8(dy, dx);
+    }
+#endif
+}
+
 void rgb_matrix_init(void) {
     rgb_matrix_driver.init();
 
+    rgb_matrix_update_geometry();
+
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
     g_last_hit_tracker.count = 0;
-    for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
-        g_last_hit_tracker.tick[i] = UINT16_MAX;
-    }
-
-    last_hit_buffer.count = 0;
-    for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
-        last_hit_buffer.tick[i] = UINT16_MAX;
-    }
+    g_last_hit_tracker.head  = 0;
+    last_hit_count           = 0;
+    last_hit_head            = 0;
+    pending_hit_count        = 0;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
     if (!eeconfig_is_enabled()) {
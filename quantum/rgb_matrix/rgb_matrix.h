@@ -107,6 +107,11 @@
 #    define RGB_MATRIX_LED_PROCESS_LIMIT ((RGB_MATRIX_LED_COUNT + 4) / 5)
 #endif
 
+// Longest an asynchronous flush may take before it is assumed lost and the next frame is flushed anyway
+#ifndef RGB_MATRIX_FLUSH_ASYNC_TIMEOUT
+#    define RGB_MATRIX_FLUSH_ASYNC_TIMEOUT 100
+#endif
+
 struct rgb_matrix_limits_t {
     uint8_t led_min_index;
     uint8_t led_max_index;
@@ -131,6 +136,15 @@ struct rgb_matrix_limits_t rgb_matrix_get_limits(uint8_t iter);
 #define RGB_MATRIX_TEST_LED_FLAGS() \
     if (!HAS_ANY_FLAGS(g_led_config.flags[i], params->flags)) continue
 
+// The last colour a runner converted, reused while neighbouring LEDs come out the same
+typedef struct {
+    bool valid;
+    HSV  hsv;
+    RGB  rgb;
+} rgb_matrix_hsv_memo_t;
+
+#define RGB_MATRIX_HSV_MEMO(name) rgb_matrix_hsv_memo_t name = {.valid = false}
+
 enum rgb_matrix_effects {
     RGB_MATRIX_NONE = 0,
 
@@ -165,9 +179,48 @@ uint8_t rgb_matrix_map_row_column_to_led(uint8_t row, uint8_t column, uint8_t *l
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue);
 void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue);
 
+void rgb_matrix_set_color_hsv_memo(rgb_matrix_hsv_memo_t *memo, uint8_t index, HSV hsv);
+
 void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed);
 
 void rgb_matrix_task(void);
+uint32_t rgb_matrix_next_deadline(void);
+
+void rgb_matrix_flush_complete(void);
+bool rgb_matrix_flush_in_progress(void);
+
+#ifdef RGB_MATRIX_RENDER_BUDGET_US
+typedef struct {
+    uint16_t fps;            // frames started during the last second
+    uint32_t dropped_frames; // RGB_MATRIX_LED_FLUSH_LIMIT periods that went by without a frame, since boot
+    uint8_t  slice_leds;     // LEDs rendered per rgb_matrix_task() call to stay within the budget
+    uint16_t led_cost_us;    // average cost of rendering one LED
+} rgb_matrix_render_stats_t;
+
+void rgb_matrix_get_render_stats(rgb_matrix_render_stats_t *stats);
+#endif
+
+#if defined(RGB_MATRIX_SPLIT) && defined(SPLIT_RGB_MATRIX_COLORS_ENABLE)
+#    ifndef RGB_MATRIX_SPLIT_COLORS_PER_SYNC
+#        define RGB_MATRIX_SPLIT_COLORS_PER_SYNC 8
+#    endif
+#    ifndef RGB_MATRIX_SPLIT_COLORS_INTERVAL
+#        define RGB_MATRIX_SPLIT_COLORS_INTERVAL RGB_MATRIX_LED_FLUSH_LIMIT
+#    endif
+
+// Color the master set on an LED of the other half, valid is cleared once the master stops setting it
+typedef struct PACKED {
+    uint8_t index;
+    bool    valid;
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+} rgb_matrix_split_color_t;
+
+uint8_t rgb_matrix_split_colors_collect(rgb_matrix_split_color_t *colors, uint8_t max, bool refresh);
+void    rgb_matrix_split_colors_resend(const rgb_matrix_split_color_t *colors, uint8_t count);
+void    rgb_matrix_split_colors_receive(const rgb_matrix_split_color_t *colors, uint8_t count);
+#endif
 
 // This runs after another backlight effect and replaces
 // colors already set
@@ -181,6 +234,9 @@ bool rgb_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max);
 
 void rgb_matrix_init(void);
 
+// Recomputes g_led_geometry, for keyboards that change g_led_config at runtime
+void rgb_matrix_update_geometry(void);
+
 void rgb_matrix_reload_from_eeprom(void);
 
 void        rgb_matrix_set_suspend_state(bool state);
@@ -279,8 +335,12 @@ typedef struct {
     void (*set_color)(int index, uint8_t r, uint8_t g, uint8_t b);
     /* Set the colour of all LEDS on the keyboard in the buffer. */
     void (*set_color_all)(uint8_t r, uint8_t g, uint8_t b);
-    /* Flush any buffered changes to the hardware. */
+    /* Flush any buffered changes to the hardware, waiting for any transfer still in progress. */
     void (*flush)(void);
+    /* Optional. Start flushing buffered changes and return without waiting for the transfer to finish.
+     * The buffer behind set_color() must be free to change once this returns, the data being sent has
+     * to be copied elsewhere. Call rgb_matrix_flush_complete() when done, from an interrupt if need be. */
+    void (*flush_async)(void);
 } rgb_matrix_driver_t;
 
 static inline bool rgb_matrix_check_finished_leds(uint8_t led_idx) {
@@ -301,8 +361,24 @@ extern rgb_config_t rgb_matrix_config;
 
 extern uint32_t     g_rgb_timer;
 extern led_config_t g_led_config;
+#ifdef RGB_MATRIX_GEOMETRY_TABLE
+extern led_geometry_t g_led_geometry[RGB_MATRIX_LED_COUNT];
+#endif
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 extern last_hit_t g_last_hit_tracker;
+
+// Slot of the j-th hit of the current frame, 0 being the oldest and count - 1 the most recent
+static inline uint8_t rgb_matrix_hit_slot(uint8_t j) {
+    uint16_t slot = g_last_hit_tracker.head + j;
+    return slot < LED_HITS_TO_REMEMBER ? slot : slot - LED_HITS_TO_REMEMBER;
+}
+
+// Milliseconds from the hit in `slot` to the start of the current frame, saturating at UINT16_MAX
+static inline uint16_t rgb_matrix_hit_tick(uint8_t slot) {
+    // Hits recorded after the frame started count as brand new
+    int32_t age = g_rgb_timer - g_last_hit_tracker.time[slot];
+    return age <= 0 ? 0 : age < UINT16_MAX ? age : UINT16_MAX;
+}
 #endif
 #ifdef RGB_MATRIX_FRAMEBUFFER_EFFECTS
 extern uint8_t g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS];
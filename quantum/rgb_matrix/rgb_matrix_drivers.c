@@ -117,6 +117,16 @@ static void flush(void) {
     }
 }
 
+// The driver copies rgb_matrix_ws2812_array into its own transmit buffer, so the next frame can be rendered while this one is sent
+static void flush_async(void) {
+    if (ws2812_dirty) {
+        ws2812_dirty = false;
+        ws2812_setleds_async(rgb_matrix_ws2812_array, RGB_MATRIX_LED_COUNT, rgb_matrix_flush_complete);
+    } else {
+        rgb_matrix_flush_complete();
+    }
+}
+
 // Set an led in the buffer to a color
 static inline void setled(int i, uint8_t r, uint8_t g, uint8_t b) {
 #    if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
@@ -154,6 +164,7 @@ static void setled_all(uint8_t r, uint8_t g, uint8_t b) {
 const rgb_matrix_driver_t rgb_matrix_driver = {
     .init          = init,
     .flush         = flush,
+    .flush_async   = flush_async,
     .set_color     = setled,
     .set_color_all = setled_all,
 };
@@ -16,6 +16,10 @@
 
 #pragma once
 
+#ifdef __cplusplus
+#    define _Static_assert static_assert
+#endif
+
 #include <stdint.h>
 #include <stdbool.h>
 #include "color.h"
@@ -30,13 +34,25 @@
 #    define LED_HITS_TO_REMEMBER 8
 #endif // LED_HITS_TO_REMEMBER
 
+// Hits that arrive while a frame is rendering wait for the next one, with fewer slots than
+// LED_HITS_TO_REMEMBER a burst within one frame can push out hits the ring would have kept
+#ifndef LED_HITS_PENDING
+#    define LED_HITS_PENDING LED_HITS_TO_REMEMBER
+#endif // LED_HITS_PENDING
+
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+_Static_assert(LED_HITS_TO_REMEMBER > 0 && LED_HITS_TO_REMEMBER <= UINT8_MAX, "LED_HITS_TO_REMEMBER must be between 1 and 255");
+_Static_assert(LED_HITS_PENDING > 0 && LED_HITS_PENDING <= LED_HITS_TO_REMEMBER, "LED_HITS_PENDING must be between 1 and LED_HITS_TO_REMEMBER");
+
+// Ring of hits, oldest first starting at slot `head`. Hits are stamped with the time they were recorded,
+// so nothing needs updating as they age. `count` and `head` describe the hits visible to the current frame.
 typedef struct PACKED {
     uint8_t  count;
+    uint8_t  head;
     uint8_t  x[LED_HITS_TO_REMEMBER];
     uint8_t  y[LED_HITS_TO_REMEMBER];
     uint8_t  index[LED_HITS_TO_REMEMBER];
-    uint16_t tick[LED_HITS_TO_REMEMBER];
+    uint32_t time[LED_HITS_TO_REMEMBER];
 } last_hit_t;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
@@ -67,6 +83,14 @@ typedef struct PACKED {
 
 #define NO_LED 255
 
+#ifdef RGB_MATRIX_GEOMETRY_TABLE
+// Polar position of an LED around k_rgb_matrix_center
+typedef struct PACKED {
+    uint8_t dist;
+    uint8_t angle;
+} led_geometry_t;
+#endif // RGB_MATRIX_GEOMETRY_TABLE
+
 typedef struct PACKED {
     uint8_t     matrix_co[MATRIX_ROWS][MATRIX_COLS];
     led_point_t point[RGB_MATRIX_LED_COUNT];
@@ -766,6 +766,7 @@ bool rgblight_get_layer_state(uint8_t layer) {
     return (rgblight_status.enabled_layer_mask & mask) != 0;
 }
 
+#    ifndef RGBLIGHT_LAYERS_COMPOSITOR
 // Write any enabled LED layers into the buffer
 static void rgblight_layers_write(void) {
 #    ifdef RGBLIGHT_LAYERS_RETAIN_VAL
@@ -801,6 +802,102 @@ static void rgblight_layers_write(void) {
         }
     }
 }
+#    else
+// Layer colors are kept apart from led[], which only ever holds the base animation frame
+static rgb_led_t                        layer_overlay[RGBLED_NUM];
+static uint8_t                          layer_covered[(RGBLED_NUM + 7) / 8];
+static const rgblight_segment_t *const *overlay_layers;
+static rgblight_layer_mask_t            overlay_layer_mask;
+static bool                             overlay_valid = false;
+#        ifdef RGBLIGHT_LAYERS_RETAIN_VAL
+static uint8_t overlay_val;
+#        endif
+
+static inline bool rgblight_layer_covers(uint8_t index) {
+    return layer_covered[index / 8] & (1 << (index % 8));
+}
+
+// Recompute the layer colors of LEDs start to end - 1, later layers taking precedence as with rgblight_layers_write()
+static void rgblight_layers_overlay_range(uint8_t start, uint8_t end) {
+    for (uint8_t k = start; k < end; k++) {
+        layer_covered[k / 8] &= ~(1 << (k % 8));
+    }
+
+    uint8_t i = 0;
+    for (const rgblight_segment_t *const *layer_ptr = rgblight_layers; i < RGBLIGHT_MAX_LAYERS; layer_ptr++, i++) {
+        const rgblight_segment_t *segment_ptr = pgm_read_ptr(layer_ptr);
+        if (segment_ptr == NULL) {
+            break; // No more layers
+        }
+        if (!rgblight_get_layer_state(i)) {
+            continue; // Layer is disabled
+        }
+        for (;; segment_ptr++) {
+            rgblight_segment_t segment;
+            memcpy_P(&segment, segment_ptr, sizeof(rgblight_segment_t));
+            if (segment.index == RGBLIGHT_END_SEGMENT_INDEX) {
+                break; // No more segments
+            }
+            uint8_t first = MAX(segment.index, start);
+            uint8_t last  = MIN(segment.index + segment.count, end);
+            if (first >= last) {
+                continue;
+            }
+            rgb_led_t color;
+#        ifdef RGBLIGHT_LAYERS_RETAIN_VAL
+            sethsv(segment.hue, segment.sat, overlay_val, &color);
+#        else
+            sethsv(segment.hue, segment.sat, segment.val, &color);
+#        endif
+            for (uint8_t k = first; k < last; k++) {
+                layer_overlay[k] = color;
+                layer_covered[k / 8] |= 1 << (k % 8);
+            }
+        }
+    }
+}
+
+// Bring the layer colors up to date, only the LEDs of layers toggled since last time are recomputed
+static void rgblight_layers_overlay_update(void) {
+    bool rebuild = !overlay_valid || overlay_layers != rgblight_layers;
+#        ifdef RGBLIGHT_LAYERS_RETAIN_VAL
+    rebuild |= overlay_val != rgblight_get_val();
+    overlay_val = rgblight_get_val();
+#        endif
+    rgblight_layer_mask_t toggled = overlay_layer_mask ^ rgblight_status.enabled_layer_mask;
+    overlay_layer_mask            = rgblight_status.enabled_layer_mask;
+    overlay_layers                = rgblight_layers;
+    overlay_valid                 = true;
+
+    if (rebuild) {
+        rgblight_layers_overlay_range(0, RGBLED_NUM);
+        return;
+    }
+
+    uint8_t i = 0;
+    for (const rgblight_segment_t *const *layer_ptr = rgblight_layers; toggled != 0 && i < RGBLIGHT_MAX_LAYERS; layer_ptr++, i++) {
+        const rgblight_segment_t *segment_ptr = pgm_read_ptr(layer_ptr);
+        if (segment_ptr == NULL) {
+            break; // No more layers
+        }
+        rgblight_layer_mask_t mask = (rgblight_layer_mask_t)1 << i;
+        if (!(toggled & mask)) {
+            continue;
+        }
+        toggled &= ~mask;
+        for (;; segment_ptr++) {
+            rgblight_segment_t segment;
+            memcpy_P(&segment, segment_ptr, sizeof(rgblight_segment_t));
+            if (segment.index == RGBLIGHT_END_SEGMENT_INDEX) {
+                break; // No more segments
+            }
+            if (segment.index < RGBLED_NUM) {
+                rgblight_layers_overlay_range(segment.index, MIN(segment.index + segment.count, RGBLED_NUM));
+            }
+        }
+    }
+}
+#    endif
 
 #    ifdef RGBLIGHT_LAYER_BLINK
 rgblight_layer_mask_t _blinking_layer_mask = 0;
@@ -909,6 +1006,9 @@ __attribute__((weak)) void rgblight_call_driver(rgb_led_t *start_led, uint8_t nu
 void rgblight_set(void) {
     rgb_led_t *start_led;
     uint8_t    num_leds = rgblight_ranges.clipping_num_leds;
+#    ifdef RGBLIGHT_LAYERS_COMPOSITOR
+    bool apply_layers = false;
+#    endif
 
     if (!rgblight_config.enable) {
         for (uint8_t i = rgblight_ranges.effect_start_pos; i < rgblight_ranges.effect_end_pos; i++) {
@@ -929,11 +1029,27 @@ void rgblight_set(void) {
         && !is_suspended
 #        endif
     ) {
+#        ifdef RGBLIGHT_LAYERS_COMPOSITOR
+        rgblight_layers_overlay_update();
+        apply_layers = true;
+#        else
         rgblight_layers_write();
+#        endif
     }
 #    endif
 
-#    ifdef RGBLIGHT_LED_MAP
+#    ifdef RGBLIGHT_LAYERS_COMPOSITOR
+    rgb_led_t frame[RGBLED_NUM];
+    for (uint8_t i = 0; i < RGBLED_NUM; i++) {
+#        ifdef RGBLIGHT_LED_MAP
+        uint8_t index = pgm_read_byte(&led_map[i]);
+#        else
+        uint8_t index = i;
+#        endif
+        frame[i] = apply_layers && rgblight_layer_covers(index) ? layer_overlay[index] : led[index];
+    }
+    start_led = frame + rgblight_ranges.clipping_start_pos;
+#    elif defined(RGBLIGHT_LED_MAP)
     rgb_led_t led0[RGBLED_NUM];
     for (uint8_t i = 0; i < RGBLED_NUM; i++) {
         led0[i] = led[pgm_read_byte(&led_map[i])];
@@ -948,6 +1064,19 @@ void rgblight_set(void) {
         convert_rgb_to_rgbw(&start_led[i]);
     }
 #    endif
+
+#    ifdef RGBLIGHT_LAYERS_COMPOSITOR
+    // The strip keeps showing the last frame, resending the same one is wasted time
+    static rgb_led_t last_frame[RGBLED_NUM];
+    static uint8_t   last_start_pos = UINT8_MAX;
+    static uint8_t   last_num_leds;
+    if (last_start_pos == rgblight_ranges.clipping_start_pos && last_num_leds == num_leds && memcmp(last_frame, start_led, num_leds * sizeof(rgb_led_t)) == 0) {
+        return;
+    }
+    memcpy(last_frame, start_led, num_leds * sizeof(rgb_led_t));
+    last_start_pos = rgblight_ranges.clipping_start_pos;
+    last_num_leds  = num_leds;
+#    endif
     rgblight_call_driver(start_led, num_leds);
 }
 #endif
@@ -1164,7 +1293,12 @@ void rgblight_timer_task(void) {
 
         // Static modes don't have a ticker running to update the LEDs
         if (rgblight_status.timer_enabled == false) {
+#        ifdef RGBLIGHT_LAYERS_COMPOSITOR
+            // led[] still holds the base frame, only the layers need compositing again
+            rgblight_set();
+#        else
             rgblight_mode_noeeprom(rgblight_config.mode);
+#        endif
         }
 
 #        ifdef RGBLIGHT_LAYERS_OVERRIDE_RGB_OFF
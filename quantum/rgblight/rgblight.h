@@ -158,6 +158,10 @@ enum RGBLIGHT_EFFECT_MODE {
 #    define RGBLIGHT_LIMIT_VAL 255
 #endif
 
+#ifdef __cplusplus
+#    define _Static_assert static_assert
+#endif
+
 #include <stdint.h>
 #include <stdbool.h>
 #include "progmem.h"
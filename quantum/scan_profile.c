@@ -0,0 +1,162 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "scan_profile.h"
+#include "timer.h"
+#include "util.h"
+
+#if defined(PROTOCOL_CHIBIOS)
+#    include <ch.h>
+#    include "chibios_config.h"
+#elif defined(__AVR__)
+#    include <avr/io.h>
+#    include "atomic_util.h"
+#    include "timer_avr.h"
+
+// Millisecond count, kept by the timer0 compare ISR in platforms/avr/timer.c
+extern volatile uint32_t timer_count;
+#endif
+
+#define SCAN_PROFILE_SUB_MASK ((1u << SCAN_PROFILE_HISTOGRAM_SUB_BITS) - 1)
+
+typedef struct {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+    uint16_t histogram[SCAN_PROFILE_HISTOGRAM_BUCKETS];
+} scan_profile_stage_data_t;
+
+static scan_profile_stage_data_t scan_profile_data[SCAN_PROFILE_STAGE_COUNT];
+
+uint32_t scan_profile_timestamp(void) {
+#if defined(PROTOCOL_CHIBIOS)
+    return (uint32_t)chSysGetRealtimeCounterX();
+#elif defined(__AVR__)
+    // Extend the 8-bit timer0 counter with the millisecond count. Timer0 runs in CTC mode,
+    // so each millisecond is TIMER_RAW_TOP + 1 counts.
+    uint32_t ms;
+    uint8_t  raw;
+    ATOMIC_BLOCK_RESTORESTATE {
+        ms  = timer_count;
+        raw = TIMER_RAW;
+#    if defined(TIFR0) && defined(OCF0A)
+        // Timer0 already wrapped, but its interrupt has not run yet
+        if (TIFR0 & _BV(OCF0A)) {
+            ms++;
+            raw = TIMER_RAW;
+        }
+#    endif
+    }
+    return ms * (TIMER_RAW_TOP + 1) + raw;
+#else
+    return timer_read32();
+#endif
+}
+
+uint32_t scan_profile_tick_frequency(void) {
+#if defined(PROTOCOL_CHIBIOS)
+    return REALTIME_COUNTER_CLOCK;
+#elif defined(__AVR__)
+    return (uint32_t)(TIMER_RAW_TOP + 1) * 1000;
+#else
+    return 1000;
+#endif
+}
+
+static uint8_t scan_profile_bucket_for(uint32_t duration) {
+    if (duration < (1u << SCAN_PROFILE_HISTOGRAM_SUB_BITS)) {
+        return duration;
+    }
+    if (duration >= (uint32_t)(((uint64_t)1 << SCAN_PROFILE_HISTOGRAM_MAX_BITS) - 1)) {
+        return SCAN_PROFILE_HISTOGRAM_BUCKETS - 1;
+    }
+
+    // Position of the most significant bit selects the power-of-two range, the following bits select the sub-bucket
+    uint8_t msb = 31 - __builtin_clz(duration);
+    uint8_t sub = (duration >> (msb - SCAN_PROFILE_HISTOGRAM_SUB_BITS)) & SCAN_PROFILE_SUB_MASK;
+    return ((msb - SCAN_PROFILE_HISTOGRAM_SUB_BITS + 1) << SCAN_PROFILE_HISTOGRAM_SUB_BITS) | sub;
+}
+
+uint32_t scan_profile_bucket_lower_bound(uint8_t bucket) {
+    if (bucket < (1u << SCAN_PROFILE_HISTOGRAM_SUB_BITS)) {
+        return bucket;
+    }
+    uint8_t msb = (bucket >> SCAN_PROFILE_HISTOGRAM_SUB_BITS) + SCAN_PROFILE_HISTOGRAM_SUB_BITS - 1;
+    return ((uint32_t)1 << msb) | ((uint32_t)(bucket & SCAN_PROFILE_SUB_MASK) << (msb - SCAN_PROFILE_HISTOGRAM_SUB_BITS));
+}
+
+void scan_profile_record(scan_profile_stage_t stage, uint32_t duration) {
+    if (stage >= SCAN_PROFILE_STAGE_COUNT) {
+        return;
+    }
+
+    scan_profile_stage_data_t *data = &scan_profile_data[stage];
+    if (data->count == 0 || duration < data->min) {
+        data->min = duration;
+    }
+    if (duration > data->max) {
+        data->max = duration;
+    }
+    if (data->count < UINT32_MAX) {
+        data->count++;
+        data->sum += duration;
+    }
+
+    uint16_t *bucket = &data->histogram[scan_profile_bucket_for(duration)];
+    if (*bucket == UINT16_MAX) {
+        // Halve the whole histogram rather than saturating, so the distribution keeps tracking recent behaviour
+        for (uint8_t i = 0; i < SCAN_PROFILE_HISTOGRAM_BUCKETS; ++i) {
+            data->histogram[i] >>= 1;
+        }
+    }
+    (*bucket)++;
+}
+
+void scan_profile_reset(void) {
+    memset(scan_profile_data, 0, sizeof(scan_profile_data));
+}
+
+bool scan_profile_get_stats(scan_profile_stage_t stage, scan_profile_stats_t *stats) {
+    if (stage >= SCAN_PROFILE_STAGE_COUNT) {
+        return false;
+    }
+
+    const scan_profile_stage_data_t *data = &scan_profile_data[stage];
+    memset(stats, 0, sizeof(*stats));
+    if (data->count == 0) {
+        return true;
+    }
+
+    stats->count = data->count;
+    stats->min   = data->min;
+    stats->max   = data->max;
+    stats->avg   = (uint32_t)(data->sum / data->count);
+
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < SCAN_PROFILE_HISTOGRAM_BUCKETS; ++i) {
+        total += data->histogram[i];
+    }
+
+    // Report the upper edge of the bucket containing the 99th percentile, clamped to the observed maximum
+    uint32_t threshold = total - total / 100;
+    uint32_t seen      = 0;
+    for (uint8_t i = 0; i < SCAN_PROFILE_HISTOGRAM_BUCKETS; ++i) {
+        seen += data->histogram[i];
+        if (seen >= threshold) {
+            uint32_t upper = (i + 1 < SCAN_PROFILE_HISTOGRAM_BUCKETS) ? scan_profile_bucket_lower_bound(i + 1) - 1 : data->max;
+            stats->p99     = MIN(upper, data->max);
+            break;
+        }
+    }
+
+    return true;
+}
+
+uint16_t scan_profile_get_histogram_bucket(scan_profile_stage_t stage, uint8_t bucket) {
+    if (stage >= SCAN_PROFILE_STAGE_COUNT || bucket >= SCAN_PROFILE_HISTOGRAM_BUCKETS) {
+        return 0;
+    }
+    return scan_profile_data[stage].histogram[bucket];
+}
@@ -0,0 +1,83 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+/*
+    Always-on, RAM-resident profiling of the individual stages of keyboard_task().
+
+    Where basic_profiling.h prints a percentage for a single call over console, this
+    keeps min/avg/max and a log-linear duration histogram per stage so the p99 can be
+    derived, and exposes them to the host (see vial_scan_profile_op in vial.h).
+
+    Usage example:
+
+        SCAN_PROFILE_BEGIN(SCAN_PROFILE_MATRIX_TASK);
+        matrix_task();
+        SCAN_PROFILE_END(SCAN_PROFILE_MATRIX_TASK);
+
+    Durations are measured in "ticks" of scan_profile_timestamp(), whose frequency is
+    reported by scan_profile_tick_frequency():
+        - ChibiOS: the realtime counter (CPU cycles on most ARM cores)
+        - AVR: timer0 ticks, (TIMER_RAW_TOP + 1) per millisecond
+        - anything else: milliseconds
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Number of mantissa bits per power-of-two histogram bucket -- higher is more precise, but uses more RAM */
+#ifndef SCAN_PROFILE_HISTOGRAM_SUB_BITS
+#    define SCAN_PROFILE_HISTOGRAM_SUB_BITS 1
+#endif
+
+/* Durations at or above (1 << SCAN_PROFILE_HISTOGRAM_MAX_BITS) ticks all land in the last bucket */
+#ifndef SCAN_PROFILE_HISTOGRAM_MAX_BITS
+#    define SCAN_PROFILE_HISTOGRAM_MAX_BITS 24
+#endif
+
+#define SCAN_PROFILE_HISTOGRAM_BUCKETS ((SCAN_PROFILE_HISTOGRAM_MAX_BITS - SCAN_PROFILE_HISTOGRAM_SUB_BITS + 1) << SCAN_PROFILE_HISTOGRAM_SUB_BITS)
+
+_Static_assert(SCAN_PROFILE_HISTOGRAM_MAX_BITS <= 32, "SCAN_PROFILE_HISTOGRAM_MAX_BITS must be 32 or less");
+_Static_assert(SCAN_PROFILE_HISTOGRAM_SUB_BITS < SCAN_PROFILE_HISTOGRAM_MAX_BITS, "SCAN_PROFILE_HISTOGRAM_SUB_BITS must be less than SCAN_PROFILE_HISTOGRAM_MAX_BITS");
+_Static_assert(SCAN_PROFILE_HISTOGRAM_BUCKETS <= 256, "Too many scan profile histogram buckets");
+
+/* The numeric values are part of the raw HID protocol -- only ever append */
+typedef enum {
+    SCAN_PROFILE_KEYBOARD_TASK = 0,
+    SCAN_PROFILE_MATRIX_TASK,
+    SCAN_PROFILE_QUANTUM_TASK,
+    SCAN_PROFILE_SPLIT_TRANSACTIONS,
+    SCAN_PROFILE_RGBLIGHT_TASK,
+    SCAN_PROFILE_LED_MATRIX_TASK,
+    SCAN_PROFILE_RGB_MATRIX_TASK,
+    SCAN_PROFILE_ENCODER_READ,
+    SCAN_PROFILE_POINTING_DEVICE_TASK,
+    SCAN_PROFILE_OLED_TASK,
+    SCAN_PROFILE_STAGE_COUNT,
+} scan_profile_stage_t;
+
+typedef struct __attribute__((packed)) {
+    uint32_t count;
+    uint32_t min;
+    uint32_t avg;
+    uint32_t max;
+    uint32_t p99;
+} scan_profile_stats_t;
+
+uint32_t scan_profile_timestamp(void);
+uint32_t scan_profile_tick_frequency(void);
+
+void scan_profile_record(scan_profile_stage_t stage, uint32_t duration);
+void scan_profile_reset(void);
+
+bool     scan_profile_get_stats(scan_profile_stage_t stage, scan_profile_stats_t *stats);
+uint16_t scan_profile_get_histogram_bucket(scan_profile_stage_t stage, uint8_t bucket);
+uint32_t scan_profile_bucket_lower_bound(uint8_t bucket);
+
+#ifdef SCAN_PROFILE_ENABLE
+#    define SCAN_PROFILE_BEGIN(stage) const uint32_t scan_profile_start_##stage = scan_profile_timestamp()
+#    define SCAN_PROFILE_END(stage) scan_profile_record(stage, scan_profile_timestamp() - scan_profile_start_##stage)
+#else
+#    define SCAN_PROFILE_BEGIN(stage)
+#    define SCAN_PROFILE_END(stage)
+#endif
@@ -23,6 +23,9 @@
 #include "keycode.h"
 #include "action.h"
 #include "wait.h"
+#ifdef SEND_STRING_ASYNC_ENABLE
+#    include "timer.h"
+#endif
 
 #if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
 #    include "audio.h"
@@ -151,6 +154,10 @@ void send_string(const char *string) {
 }
 
 void send_string_with_delay(const char *string, uint8_t interval) {
+#ifdef SEND_STRING_ASYNC_ENABLE
+    // Don't overtake text that is still queued
+    send_string_async_flush();
+#endif
     while (1) {
         char ascii_code = *string;
         if (!ascii_code) break;
@@ -284,6 +291,10 @@ void send_string_P(const char *string) {
 }
 
 void send_string_with_delay_P(const char *string, uint8_t interval) {
+#ifdef SEND_STRING_ASYNC_ENABLE
+    // Don't overtake text that is still queued
+    send_string_async_flush();
+#endif
     while (1) {
         char ascii_code = pgm_read_byte(string);
         if (!ascii_code) break;
@@ -326,3 +337,185 @@ void send_string_with_delay_P(const char *string, uint8_t interval) {
     }
 }
 #endif
+
+#ifdef SEND_STRING_ASYNC_ENABLE
+#    ifndef SEND_STRING_ASYNC_BUFFER_SIZE
+#        define SEND_STRING_ASYNC_BUFFER_SIZE 64
+#    endif
+#    ifndef SEND_STRING_ASYNC_CALLBACKS
+#        define SEND_STRING_ASYNC_CALLBACKS 4
+#    endif
+#    ifndef SEND_STRING_ASYNC_INTERVAL
+#        define SEND_STRING_ASYNC_INTERVAL 0
+#    endif
+
+/* Queue entries are an operation in the high byte and its argument in the low byte:
+ * a character to type, the keycode for SS_TAP_CODE/SS_DOWN_CODE/SS_UP_CODE, a delay of up to
+ * 255ms for SS_DELAY_CODE, or the callback slot to run.
+ */
+#    define ASYNC_CHAR 0
+#    define ASYNC_CALLBACK 0xFF
+#    define ASYNC_ENTRY(op, arg) (((uint16_t)(op) << 8) | (uint8_t)(arg))
+
+static uint16_t async_queue[SEND_STRING_ASYNC_BUFFER_SIZE];
+static uint16_t async_head  = 0;
+static uint16_t async_count = 0;
+static uint32_t async_due   = 0;
+
+static struct {
+    send_string_async_callback_t callback;
+    void *                       cb_arg;
+} async_callbacks[SEND_STRING_ASYNC_CALLBACKS];
+
+/* Performs the oldest queued entry, returns the delay it asks for before the next one */
+static uint16_t send_string_async_pop(void) {
+    uint16_t entry = async_queue[async_head];
+    uint8_t  arg   = entry & 0xFF;
+    async_head     = (async_head + 1) % SEND_STRING_ASYNC_BUFFER_SIZE;
+    async_count--;
+
+    switch (entry >> 8) {
+        case ASYNC_CHAR:
+            send_char(arg);
+            return SEND_STRING_ASYNC_INTERVAL;
+        case SS_TAP_CODE:
+            tap_code(arg);
+            return SEND_STRING_ASYNC_INTERVAL;
+        case SS_DOWN_CODE:
+            register_code(arg);
+            return SEND_STRING_ASYNC_INTERVAL;
+        case SS_UP_CODE:
+            unregister_code(arg);
+            return SEND_STRING_ASYNC_INTERVAL;
+        case SS_DELAY_CODE:
+            return arg;
+        case ASYNC_CALLBACK: {
+            send_string_async_callback_t callback = async_callbacks[arg].callback;
+            async_callbacks[arg].callback         = NULL;
+            callback(async_callbacks[arg].cb_arg);
+            return 0;
+        }
+    }
+    return 0;
+}
+
+/* Makes room by typing out the oldest entries without waiting for the main loop */
+static void send_string_async_pop_blocking(void) {
+    uint16_t ms = send_string_async_pop();
+    while (ms--) {
+        wait_ms(1);
+    }
+}
+
+static void send_string_async_push(uint8_t op, uint8_t arg) {
+    while (async_count == SEND_STRING_ASYNC_BUFFER_SIZE) {
+        send_string_async_pop_blocking();
+    }
+    if (async_count == 0) {
+        async_due = timer_read32();
+    }
+    async_queue[(async_head + async_count) % SEND_STRING_ASYNC_BUFFER_SIZE] = ASYNC_ENTRY(op, arg);
+    async_count++;
+}
+
+static void send_string_async_push_delay(uint16_t ms) {
+    while (ms > 0) {
+        uint8_t chunk = ms > UINT8_MAX ? UINT8_MAX : ms;
+        send_string_async_push(SS_DELAY_CODE, chunk);
+        ms -= chunk;
+    }
+}
+
+static char read_char(const char *string, bool progmem) {
+    return progmem ? pgm_read_byte(string) : *string;
+}
+
+static void send_string_async_queue(const char *string, uint8_t interval, bool progmem) {
+    while (1) {
+        char ascii_code = read_char(string, progmem);
+        if (!ascii_code) break;
+        if (ascii_code == SS_QMK_PREFIX) {
+            ++string;
+            ascii_code = read_char(string, progmem);
+            if (!ascii_code) break;
+            if (ascii_code == SS_TAP_CODE || ascii_code == SS_DOWN_CODE || ascii_code == SS_UP_CODE) {
+                ++string;
+                send_string_async_push(ascii_code, read_char(string, progmem));
+            } else if (ascii_code == SS_DELAY_CODE) {
+                // delay
+                uint16_t ms = 0;
+                ++string;
+                while (isdigit((uint8_t)read_char(string, progmem))) {
+                    ms *= 10;
+                    ms += read_char(string, progmem) - '0';
+                    ++string;
+                }
+                send_string_async_push_delay(ms);
+            }
+        } else {
+            send_string_async_push(ASYNC_CHAR, ascii_code);
+        }
+        ++string;
+        send_string_async_push_delay(interval);
+    }
+}
+
+void send_string_async(const char *string) {
+    send_string_async_queue(string, 0, false);
+}
+
+void send_string_async_with_delay(const char *string, uint8_t interval) {
+    send_string_async_queue(string, interval, false);
+}
+
+void send_string_async_with_delay_P(const char *string, uint8_t interval) {
+    send_string_async_queue(string, interval, true);
+}
+
+void send_string_async_callback(send_string_async_callback_t callback, void *cb_arg) {
+    while (1) {
+        for (uint8_t slot = 0; slot < SEND_STRING_ASYNC_CALLBACKS; slot++) {
+            if (async_callbacks[slot].callback == NULL) {
+                async_callbacks[slot].callback = callback;
+                async_callbacks[slot].cb_arg   = cb_arg;
+                send_string_async_push(ASYNC_CALLBACK, slot);
+                return;
+            }
+        }
+        // All slots taken, run queued entries until one frees up
+        send_string_async_pop_blocking();
+    }
+}
+
+bool send_string_async_busy(void) {
+    return async_count > 0;
+}
+
+void send_string_async_flush(void) {
+    while (async_count > 0) {
+        send_string_async_pop_blocking();
+    }
+}
+
+uint32_t send_string_async_next_deadline(void) {
+    if (async_count == 0) {
+        return UINT32_MAX;
+    }
+    uint32_t now = timer_read32();
+    return timer_expired32(now, async_due) ? 0 : async_due - now;
+}
+
+void send_string_task(void) {
+    // One keystroke per call, along with the delays and callbacks following it
+    bool typed = false;
+    while (async_count > 0 && timer_expired32(timer_read32(), async_due)) {
+        uint8_t op        = async_queue[async_head] >> 8;
+        bool    keystroke = op != SS_DELAY_CODE && op != ASYNC_CALLBACK;
+        if (keystroke && typed) {
+            break;
+        }
+        typed |= keystroke;
+        async_due = timer_read32() + send_string_async_pop();
+    }
+}
+#endif
@@ -23,6 +23,7 @@
  * \{
  */
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "progmem.h"
@@ -151,4 +152,73 @@ void send_string_with_delay_P(const char *string, uint8_t interval);
  */
 #define SEND_STRING_DELAY(string, interval) send_string_with_delay_P(PSTR(string), interval)
 
+#if defined(SEND_STRING_ASYNC_ENABLE) || defined(__DOXYGEN__)
+/**
+ * \brief Callback run once everything queued before it has been typed out.
+ *
+ * \param cb_arg The argument given to send_string_async_callback().
+ */
+typedef void (*send_string_async_callback_t)(void *cb_arg);
+
+/**
+ * \brief Queue a string of ASCII characters to be typed out from the main loop.
+ *
+ * The keyboard keeps scanning and processing keys while the queue drains, one keystroke per
+ * main loop iteration, or one per `SEND_STRING_ASYNC_INTERVAL` milliseconds if that is set.
+ * Should the queue fill up, the oldest queued keystrokes are typed out right away to make room.
+ *
+ * \param string The string to type out.
+ */
+void send_string_async(const char *string);
+
+/**
+ * \brief Queue a string of ASCII characters to be typed out from the main loop, with a delay between each character.
+ *
+ * \param string The string to type out.
+ * \param interval The amount of time, in milliseconds, to wait before typing the next character.
+ */
+void send_string_async_with_delay(const char *string, uint8_t interval);
+
+/**
+ * \brief Queue a PROGMEM string of ASCII characters to be typed out from the main loop, with a delay between each character.
+ *
+ * \param string The string to type out.
+ * \param interval The amount of time, in milliseconds, to wait before typing the next character.
+ */
+void send_string_async_with_delay_P(const char *string, uint8_t interval);
+
+/**
+ * \brief Queue a callback, run once everything queued so far has been typed out.
+ *
+ * \param callback The function to call.
+ * \param cb_arg An argument passed to the callback.
+ */
+void send_string_async_callback(send_string_async_callback_t callback, void *cb_arg);
+
+/**
+ * \brief Whether queued keystrokes or callbacks are still pending.
+ */
+bool send_string_async_busy(void);
+
+/**
+ * \brief Type out everything still queued right away, running the queued callbacks.
+ */
+void send_string_async_flush(void);
+
+/**
+ * \brief Milliseconds until the queue next needs send_string_task(), 0 if it is due or `UINT32_MAX` if the queue is empty.
+ */
+uint32_t send_string_async_next_deadline(void);
+
+/**
+ * \brief Drains the queue, called from the main loop.
+ */
+void send_string_task(void);
+
+/**
+ * \brief Shortcut macro for send_string_async_with_delay_P(PSTR(string), 0).
+ */
+#    define SEND_STRING_ASYNC(string) send_string_async_with_delay_P(PSTR(string), 0)
+#endif
+
 /** \} */
@@ -0,0 +1,178 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "split_telemetry.h"
+#include "transaction_id_define.h"
+#include "scan_profile.h"
+#include "timer.h"
+#include "print.h"
+
+static const uint16_t split_telemetry_bounds[] = SPLIT_TELEMETRY_RTT_BOUNDS;
+
+#define SPLIT_TELEMETRY_RTT_BUCKETS (sizeof(split_telemetry_bounds) / sizeof(split_telemetry_bounds[0]) + 1)
+
+typedef struct {
+    uint32_t transfers;
+    uint32_t failures;
+    uint32_t retries;
+    uint32_t bytes_out;
+    uint32_t bytes_in;
+    uint32_t checksum_failures;
+    uint32_t skipped;
+    // Round trips are kept in profiler ticks and only converted to microseconds when read
+    uint32_t rtt_sum;
+    uint32_t rtt_count;
+    uint32_t rtt_min;
+    uint32_t rtt_max;
+    uint16_t histogram[SPLIT_TELEMETRY_RTT_BUCKETS];
+} split_telemetry_data_t;
+
+static split_telemetry_data_t split_telemetry_data[NUM_TOTAL_TRANSACTIONS];
+
+// split_telemetry_bounds converted to ticks, on the first transfer
+static uint32_t split_telemetry_bound_ticks[SPLIT_TELEMETRY_RTT_BUCKETS - 1];
+static bool     split_telemetry_bounds_ready = false;
+
+// Retries are made by the handlers, which only know that their last transfer failed
+static int8_t split_telemetry_last_failed = -1;
+
+uint8_t split_telemetry_rtt_buckets(void) {
+    return SPLIT_TELEMETRY_RTT_BUCKETS;
+}
+
+uint16_t split_telemetry_rtt_bound(uint8_t bucket) {
+    return bucket < SPLIT_TELEMETRY_RTT_BUCKETS - 1 ? split_telemetry_bounds[bucket] : UINT16_MAX;
+}
+
+static uint16_t split_telemetry_ticks_to_us(uint32_t ticks, uint32_t count) {
+    uint64_t us = (uint64_t)ticks * 1000000 / scan_profile_tick_frequency() / count;
+    return us > UINT16_MAX ? UINT16_MAX : us;
+}
+
+uint32_t split_telemetry_timestamp(void) {
+    return scan_profile_timestamp();
+}
+
+void split_telemetry_record_transfer(int8_t id, bool okay, uint32_t ticks, uint16_t bytes_out, uint16_t bytes_in) {
+    if (id < 0 || id >= NUM_TOTAL_TRANSACTIONS) {
+        return;
+    }
+
+    split_telemetry_data_t *data = &split_telemetry_data[id];
+    if (!okay) {
+        data->failures++;
+        split_telemetry_last_failed = id;
+        return;
+    }
+
+    if (data->transfers == 0 || ticks < data->rtt_min) {
+        data->rtt_min = ticks;
+    }
+    if (ticks > data->rtt_max) {
+        data->rtt_max = ticks;
+    }
+    if (data->transfers < UINT32_MAX) {
+        data->transfers++;
+    }
+    if (data->rtt_sum + ticks < data->rtt_sum) {
+        // Halve rather than overflow, which keeps the average
+        data->rtt_sum >>= 1;
+        data->rtt_count >>= 1;
+    }
+    data->rtt_sum += ticks;
+    data->rtt_count++;
+    data->bytes_out += bytes_out;
+    data->bytes_in += bytes_in;
+
+    if (!split_telemetry_bounds_ready) {
+        for (uint8_t i = 0; i < SPLIT_TELEMETRY_RTT_BUCKETS - 1; i++) {
+            split_telemetry_bound_ticks[i] = (uint64_t)split_telemetry_bounds[i] * scan_profile_tick_frequency() / 1000000;
+        }
+        split_telemetry_bounds_ready = true;
+    }
+
+    uint8_t bucket = 0;
+    while (bucket < SPLIT_TELEMETRY_RTT_BUCKETS - 1 && ticks > split_telemetry_bound_ticks[bucket]) {
+        bucket++;
+    }
+    if (data->histogram[bucket] == UINT16_MAX) {
+        // Halve rather than saturate, so the distribution keeps tracking recent behaviour
+        for (uint8_t i = 0; i < SPLIT_TELEMETRY_RTT_BUCKETS; i++) {
+            data->histogram[i] >>= 1;
+        }
+    }
+    data->histogram[bucket]++;
+}
+
+void split_telemetry_record_retry(void) {
+    if (split_telemetry_last_failed >= 0) {
+        split_telemetry_data[split_telemetry_last_failed].retries++;
+    }
+}
+
+void split_telemetry_record_checksum_failure(int8_t id) {
+    if (id >= 0 && id < NUM_TOTAL_TRANSACTIONS) {
+        split_telemetry_data[id].checksum_failures++;
+    }
+}
+
+void split_telemetry_record_skip(int8_t id) {
+    if (id >= 0 && id < NUM_TOTAL_TRANSACTIONS) {
+        split_telemetry_data[id].skipped++;
+    }
+}
+
+bool split_telemetry_get_stats(int8_t id, split_telemetry_stats_t *stats) {
+    memset(stats, 0, sizeof(*stats));
+    if (id < 0 || id >= NUM_TOTAL_TRANSACTIONS) {
+        return false;
+    }
+
+    const split_telemetry_data_t *data = &split_telemetry_data[id];
+    stats->transfers                   = data->transfers;
+    stats->failures                    = data->failures;
+    stats->retries                     = data->retries;
+    stats->bytes_out                   = data->bytes_out;
+    stats->bytes_in                    = data->bytes_in;
+    stats->checksum_failures           = data->checksum_failures;
+    stats->skipped                     = data->skipped;
+    stats->rtt_min_us                  = split_telemetry_ticks_to_us(data->rtt_min, 1);
+    stats->rtt_max_us                  = split_telemetry_ticks_to_us(data->rtt_max, 1);
+    stats->rtt_avg_us                  = data->rtt_count ? split_telemetry_ticks_to_us(data->rtt_sum, data->rtt_count) : 0;
+    return true;
+}
+
+uint16_t split_telemetry_get_histogram_bucket(int8_t id, uint8_t bucket) {
+    if (id < 0 || id >= NUM_TOTAL_TRANSACTIONS || bucket >= SPLIT_TELEMETRY_RTT_BUCKETS) {
+        return 0;
+    }
+    return split_telemetry_data[id].histogram[bucket];
+}
+
+void split_telemetry_reset(void) {
+    memset(split_telemetry_data, 0, sizeof(split_telemetry_data));
+    split_telemetry_last_failed = -1;
+}
+
+void split_telemetry_print(void) {
+    for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; id++) {
+        split_telemetry_stats_t stats;
+        split_telemetry_get_stats(id, &stats);
+        if (stats.transfers == 0 && stats.failures == 0 && stats.skipped == 0) {
+            continue;
+        }
+        uprintf("split %2d: %lu ok, %lu failed, %lu retries, %lu/%lu bytes out/in\n", id, (unsigned long)stats.transfers, (unsigned long)stats.failures, (unsigned long)stats.retries, (unsigned long)stats.bytes_out, (unsigned long)stats.bytes_in);
+        uprintf("          rtt %u/%u/%u us min/avg/max, %lu bad checksums, %lu skipped\n", stats.rtt_min_us, stats.rtt_avg_us, stats.rtt_max_us, (unsigned long)stats.checksum_failures, (unsigned long)stats.skipped);
+    }
+}
+
+void split_telemetry_task(void) {
+#ifdef SPLIT_TELEMETRY_PRINT_INTERVAL
+    static uint32_t last_print = 0;
+    if (timer_elapsed32(last_print) >= SPLIT_TELEMETRY_PRINT_INTERVAL) {
+        last_print = timer_read32();
+        split_telemetry_print();
+    }
+#endif
+}
@@ -0,0 +1,63 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+/*
+    Per-transaction statistics of the split transport, kept on the master.
+
+    For every transaction ID, transport_execute_transaction() counts transfers,
+    failures and bytes moved each way, and files the round trip time into a
+    histogram. The transaction handlers add retries, checksum failures and how
+    often a read or write was skipped because the checksum or data was unchanged.
+
+    The statistics are readable over raw HID (see vial_split_telemetry_op in
+    vial.h) and can be printed to the console with split_telemetry_print(), or
+    every SPLIT_TELEMETRY_PRINT_INTERVAL milliseconds if that is defined.
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Upper bounds in microseconds of all but the last round trip time bucket */
+#ifndef SPLIT_TELEMETRY_RTT_BOUNDS
+#    define SPLIT_TELEMETRY_RTT_BOUNDS \
+        { 50, 100, 200, 500, 1000, 2000, 5000 }
+#endif
+
+typedef struct __attribute__((packed)) {
+    uint32_t transfers;
+    uint32_t failures;
+    uint32_t retries;
+    uint32_t bytes_out;
+    uint32_t bytes_in;
+    uint32_t checksum_failures;
+    uint32_t skipped;
+    uint16_t rtt_min_us;
+    uint16_t rtt_max_us;
+    uint16_t rtt_avg_us;
+} split_telemetry_stats_t;
+
+uint8_t  split_telemetry_rtt_buckets(void);
+uint16_t split_telemetry_rtt_bound(uint8_t bucket);
+
+uint32_t split_telemetry_timestamp(void);
+void     split_telemetry_record_transfer(int8_t id, bool okay, uint32_t ticks, uint16_t bytes_out, uint16_t bytes_in);
+void     split_telemetry_record_retry(void);
+void     split_telemetry_record_checksum_failure(int8_t id);
+void     split_telemetry_record_skip(int8_t id);
+
+bool     split_telemetry_get_stats(int8_t id, split_telemetry_stats_t *stats);
+uint16_t split_telemetry_get_histogram_bucket(int8_t id, uint8_t bucket);
+void     split_telemetry_reset(void);
+void     split_telemetry_print(void);
+void     split_telemetry_task(void);
+
+#ifdef SPLIT_TELEMETRY_ENABLE
+#    define SPLIT_TELEMETRY_RETRY() split_telemetry_record_retry()
+#    define SPLIT_TELEMETRY_CHECKSUM_FAILURE(id) split_telemetry_record_checksum_failure(id)
+#    define SPLIT_TELEMETRY_SKIP(id) split_telemetry_record_skip(id)
+#else
+#    define SPLIT_TELEMETRY_RETRY()
+#    define SPLIT_TELEMETRY_CHECKSUM_FAILURE(id)
+#    define SPLIT_TELEMETRY_SKIP(id)
+#endif
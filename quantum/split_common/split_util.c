@@ -22,6 +22,7 @@
 #include "debug.h"
 #include "usb_util.h"
 #include "bootloader.h"
+#include "scan_profile.h"
 
 #ifdef EE_HANDS
 #    include "eeconfig.h"
@@ -244,7 +245,9 @@ bool transport_master_if_connected(matrix_row_t master_matrix[], matrix_row_t sl
     }
 #endif // SPLIT_MAX_CONNECTION_ERRORS > 0 && SPLIT_CONNECTION_CHECK_TIMEOUT > 0
 
+    SCAN_PROFILE_BEGIN(SCAN_PROFILE_SPLIT_TRANSACTIONS);
     __attribute__((unused)) bool okay = transport_master(master_matrix, slave_matrix);
+    SCAN_PROFILE_END(SCAN_PROFILE_SPLIT_TRANSACTIONS);
 #if SPLIT_MAX_CONNECTION_ERRORS > 0
     if (!okay) {
         if (connection_errors < UINT8_MAX) {
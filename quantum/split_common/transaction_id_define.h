@@ -24,6 +24,11 @@ enum serial_transaction_id {
     GET_SLAVE_MATRIX_CHECKSUM,
     GET_SLAVE_MATRIX_DATA,
 
+#ifdef SPLIT_TRANSACTIONS_BATCHED
+    PUT_BATCH_FRAME,
+    GET_BATCH_REPLY,
+#endif // SPLIT_TRANSACTIONS_BATCHED
+
 #ifdef SPLIT_TRANSPORT_MIRROR
     PUT_MASTER_MATRIX,
 #endif // SPLIT_TRANSPORT_MIRROR
@@ -64,6 +69,9 @@ enum serial_transaction_id {
 
 #if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
     PUT_RGB_MATRIX,
+#    ifdef SPLIT_RGB_MATRIX_COLORS_ENABLE
+    PUT_RGB_MATRIX_COLORS,
+#    endif // SPLIT_RGB_MATRIX_COLORS_ENABLE
 #endif // defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
 
 #if defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)
@@ -97,6 +105,10 @@ enum serial_transaction_id {
 #endif // SPLIT_ACTIVITY_ENABLE
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+#    ifdef SPLIT_TRANSACTIONS_ASYNC_RPC
+    PUT_RPC_ASYNC_REQUEST,
+    GET_RPC_ASYNC_RESPONSE,
+#    endif // SPLIT_TRANSACTIONS_ASYNC_RPC
     PUT_RPC_INFO,
     PUT_RPC_REQ_DATA,
     EXECUTE_RPC,
@@ -29,6 +29,7 @@
 #include "transaction_id_define.h"
 #include "split_util.h"
 #include "synchronization_util.h"
+#include "split_telemetry.h"
 
 #ifdef BACKLIGHT_ENABLE
 #    include "backlight.h"
@@ -70,6 +71,18 @@
 #    define FORCED_SYNC_THROTTLE_MS 100
 #endif // FORCED_SYNC_THROTTLE_MS
 
+#ifndef SPLIT_SCHEDULER_BUDGET
+#    define SPLIT_SCHEDULER_BUDGET 32
+#endif // SPLIT_SCHEDULER_BUDGET
+
+#ifndef SPLIT_SCHEDULER_TRANSFER_OVERHEAD
+#    define SPLIT_SCHEDULER_TRANSFER_OVERHEAD 2
+#endif // SPLIT_SCHEDULER_TRANSFER_OVERHEAD
+
+#ifndef SPLIT_SCHEDULER_MAX_DEFER_MS
+#    define SPLIT_SCHEDULER_MAX_DEFER_MS FORCED_SYNC_THROTTLE_MS
+#endif // SPLIT_SCHEDULER_MAX_DEFER_MS
+
 #define sizeof_member(type, member) sizeof(((type *)NULL)->member)
 
 #define trans_initiator2target_initializer_cb(member, cb) \
@@ -80,8 +93,15 @@
     { 0, 0, sizeof_member(split_shared_memory_t, member), offsetof(split_shared_memory_t, member), cb }
 #define trans_target2initiator_initializer(member) trans_target2initiator_initializer_cb(member, NULL)
 
-#define transport_write(id, data, length) transport_execute_transaction(id, data, length, NULL, 0)
-#define transport_read(id, data, length) transport_execute_transaction(id, NULL, 0, data, length)
+#ifdef SPLIT_TRANSACTIONS_BATCHED
+static bool batch_write(int8_t id, const void *data, uint16_t length);
+static bool batch_read(int8_t id, void *data, uint16_t length);
+#    define transport_write(id, data, length) batch_write(id, data, length)
+#    define transport_read(id, data, length) batch_read(id, data, length)
+#else // SPLIT_TRANSACTIONS_BATCHED
+#    define transport_write(id, data, length) transport_execute_transaction(id, data, length, NULL, 0)
+#    define transport_read(id, data, length) transport_execute_transaction(id, NULL, 0, data, length)
+#endif // SPLIT_TRANSACTIONS_BATCHED
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 // Forward-declare the RPC callback handlers
@@ -96,6 +116,7 @@ static bool transaction_handler_master(matrix_row_t master_matrix[], matrix_row_
     int num_retries = is_transport_connected() ? 10 : 1;
     for (int iter = 1; iter <= num_retries; ++iter) {
         if (iter > 1) {
+            SPLIT_TELEMETRY_RETRY();
             for (int i = 0; i < iter * iter; ++i) {
                 wait_us(10);
             }
@@ -113,6 +134,53 @@ static bool transaction_handler_master(matrix_row_t master_matrix[], matrix_row_
         if (!transaction_handler_master(master_matrix, slave_matrix, #prefix, &prefix##_handlers_master)) return false; \
     } while (0)
 
+typedef enum {
+    SPLIT_PRIORITY_INPUT,    // matrix, encoders and pointing device, always run
+    SPLIT_PRIORITY_STATE,    // layers, mods, LEDs and other state the slave acts on
+    SPLIT_PRIORITY_COSMETIC, // lighting, displays and statistics
+} split_priority_t;
+
+#ifdef SPLIT_TRANSACTIONS_SCHEDULED
+
+// Bytes left to spend this scan; every transfer is charged, including RPCs, so a busy scan leaves less for the next one
+static int16_t scheduler_tokens = SPLIT_SCHEDULER_BUDGET;
+
+static void scheduler_spend(uint16_t bytes) {
+    int32_t tokens   = (int32_t)scheduler_tokens - bytes;
+    scheduler_tokens = tokens < -INT16_MAX ? -INT16_MAX : tokens;
+}
+
+void transactions_scheduler_charge(uint16_t bytes) {
+    scheduler_spend(bytes + SPLIT_SCHEDULER_TRANSFER_OVERHEAD);
+}
+
+static void scheduler_refill(void) {
+    scheduler_tokens = scheduler_tokens + SPLIT_SCHEDULER_BUDGET > SPLIT_SCHEDULER_BUDGET ? SPLIT_SCHEDULER_BUDGET : scheduler_tokens + SPLIT_SCHEDULER_BUDGET;
+}
+
+// Once the budget is spent, lower priority handlers wait for a later scan, but never longer than SPLIT_SCHEDULER_MAX_DEFER_MS
+static bool scheduler_admit(split_priority_t priority, uint32_t *last_run) {
+    if (priority != SPLIT_PRIORITY_INPUT && scheduler_tokens <= 0 && timer_elapsed32(*last_run) < SPLIT_SCHEDULER_MAX_DEFER_MS) {
+        return false;
+    }
+    *last_run = timer_read32();
+    return true;
+}
+
+#    define TRANSACTION_HANDLER_MASTER_SCHEDULED(prefix, priority) \
+        do {                                                        \
+            static uint32_t last_run = 0;                           \
+            if (scheduler_admit(priority, &last_run)) {             \
+                TRANSACTION_HANDLER_MASTER(prefix);                 \
+            }                                                       \
+        } while (0)
+
+#else // SPLIT_TRANSACTIONS_SCHEDULED
+
+#    define TRANSACTION_HANDLER_MASTER_SCHEDULED(prefix, priority) TRANSACTION_HANDLER_MASTER(prefix)
+
+#endif // SPLIT_TRANSACTIONS_SCHEDULED
+
 /**
  * @brief Constructs a transaction handler that doesn't acquire a lock to the
  * split shared memory. Therefore the locking and unlocking has to be done
@@ -144,11 +212,17 @@ inline static bool read_if_checksum_mismatch(int8_t trans_id_checksum, int8_t tr
     bool    okay = transport_read(trans_id_checksum, &curr_checksum, sizeof(curr_checksum));
     if (okay && (timer_elapsed32(*last_update) >= FORCED_SYNC_THROTTLE_MS || curr_checksum != crc8(equiv_shmem, length))) {
         okay &= transport_read(trans_id_retrieve, destination, length);
-        okay &= curr_checksum == crc8(equiv_shmem, length);
+        if (okay && curr_checksum != crc8(equiv_shmem, length)) {
+            SPLIT_TELEMETRY_CHECKSUM_FAILURE(trans_id_retrieve);
+            okay = false;
+        }
         if (okay) {
             *last_update = timer_read32();
         }
     } else {
+        if (okay) {
+            SPLIT_TELEMETRY_SKIP(trans_id_retrieve);
+        }
         memcpy(destination, equiv_shmem, length);
     }
     return okay;
@@ -161,6 +235,8 @@ inline static bool send_if_condition(int8_t trans_id, uint32_t *last_update, boo
         if (okay) {
             *last_update = timer_read32();
         }
+    } else {
+        SPLIT_TELEMETRY_SKIP(trans_id);
     }
     return okay;
 }
@@ -170,6 +246,176 @@ inline static bool send_if_data_mismatch(int8_t trans_id, uint32_t *last_update,
     return send_if_condition(trans_id, last_update, (memcmp(source, equiv_shmem, length) != 0), source, length);
 }
 
+////////////////////////////////////////////////////
+// Batched frames
+
+#ifdef SPLIT_TRANSACTIONS_BATCHED
+
+// Writes queued this scan, sent as the next frame once the slave has applied the one in flight
+static split_batch_frame_t batch_pending;
+static split_batch_frame_t batch_inflight;
+static bool                batch_awaiting_ack = false;
+static uint32_t            batch_sent_time    = 0;
+static bool                batch_synced       = false;
+static uint8_t             batch_applied_seq  = 0;
+
+// RPC steps must reach the slave in order and callbacks must run as each transfer arrives, so those still go out one by one
+static bool batch_is_direct(int8_t id) {
+#    ifndef DISABLE_SYNC_TIMER
+    // Stamped as it is written, so it would be stale by the time a queued frame went out
+    if (id == PUT_SYNC_TIMER) {
+        return true;
+    }
+#    endif // DISABLE_SYNC_TIMER
+#    if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+    if (id >= PUT_RPC_INFO && id <= GET_RPC_RESP_DATA) {
+        return true;
+    }
+#    endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+    return split_transaction_table[id].slave_callback != NULL;
+}
+
+static bool batch_write(int8_t id, const void *data, uint16_t length) {
+    if (batch_is_direct(id)) {
+        return transport_execute_transaction(id, data, length, NULL, 0);
+    }
+
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    uint8_t                   len   = trans->initiator2target_buffer_size < length ? trans->initiator2target_buffer_size : length;
+    uint8_t                   i     = 0;
+    // A newer value for a transaction already queued replaces the old one
+    while (i < batch_pending.length && !(batch_pending.data[i] == id && batch_pending.data[i + 1] == len)) {
+        i += 2 + batch_pending.data[i + 1];
+    }
+    if (i == batch_pending.length) {
+        if (batch_pending.length + 2 + len > SPLIT_BATCH_FRAME_SIZE) {
+            return transport_execute_transaction(id, data, length, NULL, 0);
+        }
+        batch_pending.data[i]     = id;
+        batch_pending.data[i + 1] = len;
+        batch_pending.length += 2 + len;
+    }
+    memcpy(&batch_pending.data[i + 2], data, len);
+
+    // Keep the local copy in step, as a direct transfer would
+    memcpy(split_trans_initiator2target_buffer(trans), data, len);
+    return true;
+}
+
+// Everything the master reads was already brought over by this scan's reply
+static bool batch_read(int8_t id, void *data, uint16_t length) {
+    if (batch_is_direct(id)) {
+        return transport_execute_transaction(id, NULL, 0, data, length);
+    }
+
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    uint8_t                   len   = trans->target2initiator_buffer_size < length ? trans->target2initiator_buffer_size : length;
+    memcpy(data, split_trans_target2initiator_buffer(trans), len);
+    return true;
+}
+
+static bool batch_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    bool send = false;
+    if (!batch_synced) {
+        // Nothing goes out until the reply gives the slave's last applied frame, so a restarted master's are not taken for it
+    } else if (!batch_awaiting_ack && batch_pending.length > 0) {
+        batch_inflight.seq    = batch_inflight.seq == UINT8_MAX ? 1 : batch_inflight.seq + 1;
+        batch_inflight.length = batch_pending.length;
+        memcpy(batch_inflight.data, batch_pending.data, batch_pending.length);
+        batch_inflight.checksum = crc8(&batch_inflight.seq, 2 + batch_inflight.length);
+        batch_pending.length    = 0;
+        batch_awaiting_ack      = true;
+        send                    = true;
+    } else if (batch_awaiting_ack && timer_elapsed32(batch_sent_time) >= SPLIT_BATCH_RESEND_MS) {
+        // Lost or corrupted on the way, the slave ignores a frame it has already applied
+        send = true;
+    }
+
+    split_batch_reply_t reply;
+    bool                okay;
+    if (send) {
+        okay = transport_execute_transaction(PUT_BATCH_FRAME, &batch_inflight, offsetof(split_batch_frame_t, data) + batch_inflight.length, &reply, sizeof(reply));
+        if (okay) {
+            batch_sent_time = timer_read32();
+        }
+    } else {
+        okay = transport_execute_transaction(GET_BATCH_REPLY, NULL, 0, &reply, sizeof(reply));
+    }
+    if (!okay || reply.checksum != crc8(&reply.applied_seq, sizeof(reply) - 1)) {
+        return false;
+    }
+
+    if (!batch_synced) {
+        batch_inflight.seq = reply.applied_seq;
+        batch_synced       = true;
+    } else if (batch_awaiting_ack && reply.applied_seq == batch_inflight.seq) {
+        batch_awaiting_ack = false;
+    }
+    memcpy(&split_shmem->smatrix, &reply.smatrix, sizeof(reply.smatrix));
+#    ifdef ENCODER_ENABLE
+    memcpy(&split_shmem->encoders, &reply.encoders, sizeof(reply.encoders));
+#    endif // ENCODER_ENABLE
+#    if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+    split_shmem->pointing.checksum = reply.pointing_checksum;
+    memcpy(&split_shmem->pointing.report, &reply.pointing_report, sizeof(reply.pointing_report));
+#    endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+    return true;
+}
+
+// Applies a new frame before the handlers below act on what it carried
+static void batch_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    split_batch_frame_t *frame = &split_shmem->batch_frame;
+    // The link only takes as much of a frame as its header asks for, and none of it if that is more than fits, so the checksum covers exactly what came in
+    if (frame->seq == 0 || frame->seq == batch_applied_seq || split_trans_initiator2target_length(PUT_BATCH_FRAME, &split_transaction_table[PUT_BATCH_FRAME], frame) == 0 || frame->checksum != crc8(&frame->seq, 2 + frame->length)) {
+        return;
+    }
+
+    uint8_t i = 0;
+    while (i + 2 <= frame->length) {
+        int8_t  id  = frame->data[i];
+        uint8_t len = frame->data[i + 1];
+        if (id < 0 || id >= NUM_TOTAL_TRANSACTIONS || len > split_transaction_table[id].initiator2target_buffer_size || i + 2 + len > frame->length) {
+            break;
+        }
+        memcpy(split_trans_initiator2target_buffer(&split_transaction_table[id]), &frame->data[i + 2], len);
+        i += 2 + len;
+    }
+    batch_applied_seq = frame->seq;
+}
+
+// Runs after the handlers, so the reply carries this pass's matrix
+static void batch_reply_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    split_batch_reply_t *reply = &split_shmem->batch_reply;
+    reply->applied_seq         = batch_applied_seq;
+    memcpy(&reply->smatrix, &split_shmem->smatrix, sizeof(reply->smatrix));
+#    ifdef ENCODER_ENABLE
+    memcpy(&reply->encoders, &split_shmem->encoders, sizeof(reply->encoders));
+#    endif // ENCODER_ENABLE
+#    if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+    reply->pointing_checksum = split_shmem->pointing.checksum;
+    memcpy(&reply->pointing_report, &split_shmem->pointing.report, sizeof(reply->pointing_report));
+#    endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+    reply->checksum = crc8(&reply->applied_seq, sizeof(*reply) - 1);
+}
+
+// clang-format off
+#    define TRANSACTIONS_BATCH_MASTER() TRANSACTION_HANDLER_MASTER(batch)
+#    define TRANSACTIONS_BATCH_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(batch)
+#    define TRANSACTIONS_BATCH_REPLY_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(batch_reply)
+#    define TRANSACTIONS_BATCH_REGISTRATIONS \
+    [PUT_BATCH_FRAME] = { sizeof_member(split_shared_memory_t, batch_frame), offsetof(split_shared_memory_t, batch_frame), sizeof_member(split_shared_memory_t, batch_reply), offsetof(split_shared_memory_t, batch_reply), NULL }, \
+    [GET_BATCH_REPLY] = trans_target2initiator_initializer(batch_reply),
+// clang-format on
+
+#else // SPLIT_TRANSACTIONS_BATCHED
+
+#    define TRANSACTIONS_BATCH_MASTER()
+#    define TRANSACTIONS_BATCH_SLAVE()
+#    define TRANSACTIONS_BATCH_REPLY_SLAVE()
+#    define TRANSACTIONS_BATCH_REGISTRATIONS
+
+#endif // SPLIT_TRANSACTIONS_BATCHED
+
 ////////////////////////////////////////////////////
 // Slave matrix
 
@@ -294,7 +540,7 @@ static void sync_timer_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
     }
 }
 
-#    define TRANSACTIONS_SYNC_TIMER_MASTER() TRANSACTION_HANDLER_MASTER(sync_timer)
+#    define TRANSACTIONS_SYNC_TIMER_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(sync_timer, SPLIT_PRIORITY_STATE)
 #    define TRANSACTIONS_SYNC_TIMER_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(sync_timer)
 #    define TRANSACTIONS_SYNC_TIMER_REGISTRATIONS [PUT_SYNC_TIMER] = trans_initiator2target_initializer(sync_timer),
 
@@ -328,7 +574,7 @@ static void layer_state_handlers_slave(matrix_row_t master_matrix[], matrix_row_
 }
 
 // clang-format off
-#    define TRANSACTIONS_LAYER_STATE_MASTER() TRANSACTION_HANDLER_MASTER(layer_state)
+#    define TRANSACTIONS_LAYER_STATE_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(layer_state, SPLIT_PRIORITY_STATE)
 #    define TRANSACTIONS_LAYER_STATE_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(layer_state)
 #    define TRANSACTIONS_LAYER_STATE_REGISTRATIONS \
     [PUT_LAYER_STATE]         = trans_initiator2target_initializer(layers.layer_state), \
@@ -359,7 +605,7 @@ static void led_state_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
     set_split_host_keyboard_leds(split_shmem->led_state);
 }
 
-#    define TRANSACTIONS_LED_STATE_MASTER() TRANSACTION_HANDLER_MASTER(led_state)
+#    define TRANSACTIONS_LED_STATE_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(led_state, SPLIT_PRIORITY_STATE)
 #    define TRANSACTIONS_LED_STATE_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(led_state)
 #    define TRANSACTIONS_LED_STATE_REGISTRATIONS [PUT_LED_STATE] = trans_initiator2target_initializer(led_state),
 
@@ -421,7 +667,7 @@ static void mods_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave
 #    endif
 }
 
-#    define TRANSACTIONS_MODS_MASTER() TRANSACTION_HANDLER_MASTER(mods)
+#    define TRANSACTIONS_MODS_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(mods, SPLIT_PRIORITY_STATE)
 #    define TRANSACTIONS_MODS_SLAVE() TRANSACTION_HANDLER_SLAVE(mods)
 #    define TRANSACTIONS_MODS_REGISTRATIONS [PUT_MODS] = trans_initiator2target_initializer(mods),
 
@@ -452,7 +698,7 @@ static void backlight_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
     backlight_level_noeeprom(backlight_level);
 }
 
-#    define TRANSACTIONS_BACKLIGHT_MASTER() TRANSACTION_HANDLER_MASTER(backlight)
+#    define TRANSACTIONS_BACKLIGHT_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(backlight, SPLIT_PRIORITY_COSMETIC)
 #    define TRANSACTIONS_BACKLIGHT_SLAVE() TRANSACTION_HANDLER_SLAVE(backlight)
 #    define TRANSACTIONS_BACKLIGHT_REGISTRATIONS [PUT_BACKLIGHT] = trans_initiator2target_initializer(backlight_level),
 
@@ -494,7 +740,7 @@ static void rgblight_handlers_slave(matrix_row_t master_matrix[], matrix_row_t s
     }
 }
 
-#    define TRANSACTIONS_RGBLIGHT_MASTER() TRANSACTION_HANDLER_MASTER(rgblight)
+#    define TRANSACTIONS_RGBLIGHT_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(rgblight, SPLIT_PRIORITY_COSMETIC)
 #    define TRANSACTIONS_RGBLIGHT_SLAVE() TRANSACTION_HANDLER_SLAVE(rgblight)
 #    define TRANSACTIONS_RGBLIGHT_REGISTRATIONS [PUT_RGBLIGHT] = trans_initiator2target_initializer(rgblight_sync),
 
@@ -528,7 +774,7 @@ static void led_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
     led_matrix_set_suspend_state(led_suspend_state);
 }
 
-#    define TRANSACTIONS_LED_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(led_matrix)
+#    define TRANSACTIONS_LED_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(led_matrix, SPLIT_PRIORITY_COSMETIC)
 #    define TRANSACTIONS_LED_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE(led_matrix)
 #    define TRANSACTIONS_LED_MATRIX_REGISTRATIONS [PUT_LED_MATRIX] = trans_initiator2target_initializer(led_matrix_sync),
 
@@ -562,15 +808,71 @@ static void rgb_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
     rgb_matrix_set_suspend_state(rgb_suspend_state);
 }
 
-#    define TRANSACTIONS_RGB_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(rgb_matrix)
+#    define TRANSACTIONS_RGB_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(rgb_matrix, SPLIT_PRIORITY_COSMETIC)
 #    define TRANSACTIONS_RGB_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE(rgb_matrix)
 #    define TRANSACTIONS_RGB_MATRIX_REGISTRATIONS [PUT_RGB_MATRIX] = trans_initiator2target_initializer(rgb_matrix_sync),
 
+#    ifdef SPLIT_RGB_MATRIX_COLORS_ENABLE
+
+// Only LEDs whose color changed are sent, a few at a time so the link stays free for the matrix
+static bool rgb_matrix_colors_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static uint32_t last_update = 0;
+    uint32_t        elapsed     = timer_elapsed32(last_update);
+    if (elapsed < RGB_MATRIX_SPLIT_COLORS_INTERVAL) {
+        return true;
+    }
+
+    // Every so often, even without changes, LEDs are resent in turn in case the slave restarted
+    bool                     refresh = elapsed >= FORCED_SYNC_THROTTLE_MS;
+    rgb_matrix_colors_sync_t colors_sync;
+    colors_sync.count = rgb_matrix_split_colors_collect(colors_sync.colors, RGB_MATRIX_SPLIT_COLORS_PER_SYNC, refresh);
+    if (colors_sync.count == 0) {
+        return true;
+    }
+
+    bool okay = transport_write(PUT_RGB_MATRIX_COLORS, &colors_sync, sizeof(colors_sync));
+    if (okay) {
+        last_update = timer_read32();
+    } else {
+        rgb_matrix_split_colors_resend(colors_sync.colors, colors_sync.count);
+    }
+    return okay;
+}
+
+static void rgb_matrix_colors_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    rgb_matrix_colors_sync_t colors_sync;
+    split_shared_memory_lock();
+    memcpy(&colors_sync, &split_shmem->rgb_matrix_colors_sync, sizeof(colors_sync));
+    // Received colors are only applied once
+    split_shmem->rgb_matrix_colors_sync.count = 0;
+    split_shared_memory_unlock();
+
+    if (colors_sync.count > RGB_MATRIX_SPLIT_COLORS_PER_SYNC) {
+        colors_sync.count = RGB_MATRIX_SPLIT_COLORS_PER_SYNC;
+    }
+    rgb_matrix_split_colors_receive(colors_sync.colors, colors_sync.count);
+}
+
+#        define TRANSACTIONS_RGB_MATRIX_COLORS_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(rgb_matrix_colors, SPLIT_PRIORITY_COSMETIC)
+#        define TRANSACTIONS_RGB_MATRIX_COLORS_SLAVE() TRANSACTION_HANDLER_SLAVE(rgb_matrix_colors)
+#        define TRANSACTIONS_RGB_MATRIX_COLORS_REGISTRATIONS [PUT_RGB_MATRIX_COLORS] = trans_initiator2target_initializer(rgb_matrix_colors_sync),
+
+#    else // SPLIT_RGB_MATRIX_COLORS_ENABLE
+
+#        define TRANSACTIONS_RGB_MATRIX_COLORS_MASTER()
+#        define TRANSACTIONS_RGB_MATRIX_COLORS_SLAVE()
+#        define TRANSACTIONS_RGB_MATRIX_COLORS_REGISTRATIONS
+
+#    endif // SPLIT_RGB_MATRIX_COLORS_ENABLE
+
 #else // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 
 #    define TRANSACTIONS_RGB_MATRIX_MASTER()
 #    define TRANSACTIONS_RGB_MATRIX_SLAVE()
 #    define TRANSACTIONS_RGB_MATRIX_REGISTRATIONS
+#    define TRANSACTIONS_RGB_MATRIX_COLORS_MASTER()
+#    define TRANSACTIONS_RGB_MATRIX_COLORS_SLAVE()
+#    define TRANSACTIONS_RGB_MATRIX_COLORS_REGISTRATIONS
 
 #endif // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 
@@ -589,7 +891,7 @@ static void wpm_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_
     set_current_wpm(split_shmem->current_wpm);
 }
 
-#    define TRANSACTIONS_WPM_MASTER() TRANSACTION_HANDLER_MASTER(wpm)
+#    define TRANSACTIONS_WPM_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(wpm, SPLIT_PRIORITY_COSMETIC)
 #    define TRANSACTIONS_WPM_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(wpm)
 #    define TRANSACTIONS_WPM_REGISTRATIONS [PUT_WPM] = trans_initiator2target_initializer(current_wpm),
 
@@ -624,7 +926,7 @@ static void oled_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave
     }
 }
 
-#    define TRANSACTIONS_OLED_MASTER() TRANSACTION_HANDLER_MASTER(oled)
+#    define TRANSACTIONS_OLED_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(oled, SPLIT_PRIORITY_COSMETIC)
 #    define TRANSACTIONS_OLED_SLAVE() TRANSACTION_HANDLER_SLAVE(oled)
 #    define TRANSACTIONS_OLED_REGISTRATIONS [PUT_OLED] = trans_initiator2target_initializer(current_oled_state),
 
@@ -659,7 +961,7 @@ static void st7565_handlers_slave(matrix_row_t master_matrix[], matrix_row_t sla
     }
 }
 
-#    define TRANSACTIONS_ST7565_MASTER() TRANSACTION_HANDLER_MASTER(st7565)
+#    define TRANSACTIONS_ST7565_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(st7565, SPLIT_PRIORITY_COSMETIC)
 #    define TRANSACTIONS_ST7565_SLAVE() TRANSACTION_HANDLER_SLAVE(st7565)
 #    define TRANSACTIONS_ST7565_REGISTRATIONS [PUT_ST7565] = trans_initiator2target_initializer(current_st7565_state),
 
@@ -773,7 +1075,7 @@ static void watchdog_handlers_slave(matrix_row_t master_matrix[], matrix_row_t s
     split_watchdog_update(split_shmem->watchdog_pinged);
 }
 
-#    define TRANSACTIONS_WATCHDOG_MASTER() TRANSACTION_HANDLER_MASTER(watchdog)
+#    define TRANSACTIONS_WATCHDOG_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(watchdog, SPLIT_PRIORITY_STATE)
 #    define TRANSACTIONS_WATCHDOG_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(watchdog)
 #    define TRANSACTIONS_WATCHDOG_REGISTRATIONS [PUT_WATCHDOG] = trans_initiator2target_initializer(watchdog_pinged),
 
@@ -814,7 +1116,7 @@ static void haptic_handlers_slave(matrix_row_t master_matrix[], matrix_row_t sla
 }
 
 // clang-format off
-#    define TRANSACTIONS_HAPTIC_MASTER() TRANSACTION_HANDLER_MASTER(haptic)
+#    define TRANSACTIONS_HAPTIC_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(haptic, SPLIT_PRIORITY_STATE)
 #    define TRANSACTIONS_HAPTIC_SLAVE() TRANSACTION_HANDLER_SLAVE(haptic)
 #    define TRANSACTIONS_HAPTIC_REGISTRATIONS [PUT_HAPTIC] = trans_initiator2target_initializer(haptic_sync),
 // clang-format on
@@ -843,7 +1145,7 @@ static void activity_handlers_slave(matrix_row_t master_matrix[], matrix_row_t s
 }
 
 // clang-format off
-#    define TRANSACTIONS_ACTIVITY_MASTER() TRANSACTION_HANDLER_MASTER(activity)
+#    define TRANSACTIONS_ACTIVITY_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(activity, SPLIT_PRIORITY_COSMETIC)
 #    define TRANSACTIONS_ACTIVITY_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(activity)
 #    define TRANSACTIONS_ACTIVITY_REGISTRATIONS [PUT_ACTIVITY] = trans_initiator2target_initializer(activity_sync),
 // clang-format on
@@ -872,7 +1174,7 @@ static void detected_os_handlers_slave(matrix_row_t master_matrix[], matrix_row_
     slave_update_detected_host_os(split_shmem->detected_os);
 }
 
-#    define TRANSACTIONS_DETECTED_OS_MASTER() TRANSACTION_HANDLER_MASTER(detected_os)
+#    define TRANSACTIONS_DETECTED_OS_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(detected_os, SPLIT_PRIORITY_STATE)
 #    define TRANSACTIONS_DETECTED_OS_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(detected_os)
 #    define TRANSACTIONS_DETECTED_OS_REGISTRATIONS [PUT_DETECTED_OS] = trans_initiator2target_initializer(detected_os),
 
@@ -884,6 +1186,156 @@ static void detected_os_handlers_slave(matrix_row_t master_matrix[], matrix_row_
 
 #endif // defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
 
+////////////////////////////////////////////////////
+// Asynchronous RPC
+
+#if (defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)) && defined(SPLIT_TRANSACTIONS_ASYNC_RPC)
+
+typedef struct {
+    int8_t               transaction_id;
+    uint8_t              m2s_length;
+    uint8_t              s2m_length;
+    uint8_t              data[RPC_M2S_BUFFER_SIZE];
+    rpc_async_callback_t callback;
+    void                *cb_arg;
+} rpc_async_call_t;
+
+static rpc_async_call_t          rpc_async_queue[SPLIT_RPC_ASYNC_QUEUE_SIZE];
+static uint8_t                   rpc_async_head     = 0;
+static uint8_t                   rpc_async_count    = 0;
+static split_rpc_async_request_t rpc_async_inflight = {0};
+static uint8_t                   rpc_async_attempts = 0;
+static uint32_t                  rpc_async_sent     = 0;
+static bool                      rpc_async_synced   = false;
+
+bool transaction_rpc_exec_async(int8_t transaction_id, uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, rpc_async_callback_t callback, void *cb_arg) {
+    // Same checks as the blocking call, made up front so a queued call can only fail on the link
+    if (!is_transport_connected()) {
+        return false;
+    }
+    if (transaction_id <= GET_RPC_RESP_DATA) return false;
+    if (initiator2target_buffer_size > RPC_M2S_BUFFER_SIZE) return false;
+    if (target2initiator_buffer_size > RPC_S2M_BUFFER_SIZE) return false;
+    if (rpc_async_count == SPLIT_RPC_ASYNC_QUEUE_SIZE) return false;
+
+    rpc_async_call_t *call = &rpc_async_queue[(rpc_async_head + rpc_async_count) % SPLIT_RPC_ASYNC_QUEUE_SIZE];
+    call->transaction_id   = transaction_id;
+    call->m2s_length       = initiator2target_buffer_size;
+    call->s2m_length       = target2initiator_buffer_size;
+    call->callback         = callback;
+    call->cb_arg           = cb_arg;
+    memcpy(call->data, initiator2target_buffer, initiator2target_buffer_size);
+    rpc_async_count++;
+    return true;
+}
+
+static void rpc_async_complete(bool success, const split_rpc_async_response_t *response) {
+    rpc_async_call_t *call = &rpc_async_queue[rpc_async_head];
+    rpc_async_head         = (rpc_async_head + 1) % SPLIT_RPC_ASYNC_QUEUE_SIZE;
+    rpc_async_count--;
+    rpc_async_attempts = 0;
+    if (call->callback) {
+        call->callback(call->transaction_id, success, success ? response->length : 0, success ? response->data : NULL, call->cb_arg);
+    }
+}
+
+// One call is in flight at a time: its request goes out in a single transfer, and the
+// response is polled on the following scans, once the slave has run the call
+static bool rpc_async_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    if (rpc_async_count == 0) {
+        return true;
+    }
+
+    split_rpc_async_response_t response = {0};
+    bool                       okay;
+    if (!rpc_async_synced) {
+        // Carry on from the slave's last sequence number, so a restarted master isn't answered with a stale response
+        okay = transport_execute_transaction(GET_RPC_ASYNC_RESPONSE, NULL, 0, &response, sizeof(response));
+        if (okay && response.checksum == crc8(&response.seq, sizeof(response) - 1)) {
+            rpc_async_inflight.seq = response.seq;
+            rpc_async_synced       = true;
+        }
+        return okay;
+    }
+    if (rpc_async_attempts == 0 || timer_elapsed32(rpc_async_sent) >= SPLIT_RPC_ASYNC_RESEND_MS) {
+        if (rpc_async_attempts == SPLIT_RPC_ASYNC_ATTEMPTS) {
+            rpc_async_complete(false, NULL);
+            return true;
+        }
+        if (rpc_async_attempts == 0) {
+            const rpc_async_call_t *call      = &rpc_async_queue[rpc_async_head];
+            rpc_async_inflight.seq            = rpc_async_inflight.seq == UINT8_MAX ? 1 : rpc_async_inflight.seq + 1;
+            rpc_async_inflight.transaction_id = call->transaction_id;
+            rpc_async_inflight.m2s_length     = call->m2s_length;
+            rpc_async_inflight.s2m_length     = call->s2m_length;
+            memcpy(rpc_async_inflight.data, call->data, call->m2s_length);
+            rpc_async_inflight.checksum = crc8(&rpc_async_inflight.seq, sizeof(rpc_async_inflight) - 1);
+        }
+        // A resend of a request the slave already ran only fetches its response again
+        okay = transport_execute_transaction(PUT_RPC_ASYNC_REQUEST, &rpc_async_inflight, sizeof(rpc_async_inflight), &response, sizeof(response));
+        if (okay) {
+            rpc_async_attempts++;
+            rpc_async_sent = timer_read32();
+        }
+    } else {
+        okay = transport_execute_transaction(GET_RPC_ASYNC_RESPONSE, NULL, 0, &response, sizeof(response));
+    }
+
+    if (okay && response.seq == rpc_async_inflight.seq && response.length <= RPC_S2M_BUFFER_SIZE && response.checksum == crc8(&response.seq, sizeof(response) - 1)) {
+        rpc_async_complete(true, &response);
+    }
+    return okay;
+}
+
+// Runs the call outside of the transport's interrupt or callback, with the lock held only to copy in and out
+static void rpc_async_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    split_rpc_async_request_t  request;
+    split_rpc_async_response_t response = {0};
+
+    split_shared_memory_lock();
+    memcpy(&request, &split_shmem->rpc_async_request, sizeof(request));
+    if (split_shmem->rpc_async_response.checksum != crc8(&split_shmem->rpc_async_response.seq, sizeof(response) - 1)) {
+        // Nothing run since boot, give the master a valid sequence number to start from
+        response.checksum = crc8(&response.seq, sizeof(response) - 1);
+        memcpy(&split_shmem->rpc_async_response, &response, sizeof(response));
+    }
+    response.seq = split_shmem->rpc_async_response.seq;
+    split_shared_memory_unlock();
+
+    if (request.seq == 0 || request.seq == response.seq || request.checksum != crc8(&request.seq, sizeof(request) - 1)) {
+        return;
+    }
+    if (request.transaction_id > GET_RPC_RESP_DATA && request.transaction_id < NUM_TOTAL_TRANSACTIONS && request.m2s_length <= RPC_M2S_BUFFER_SIZE && request.s2m_length <= RPC_S2M_BUFFER_SIZE) {
+        split_transaction_desc_t *trans = &split_transaction_table[request.transaction_id];
+        if (trans->slave_callback) {
+            trans->slave_callback(request.m2s_length, request.data, request.s2m_length, response.data);
+        }
+        response.length = request.s2m_length;
+    }
+    response.seq      = request.seq;
+    response.checksum = crc8(&response.seq, sizeof(response) - 1);
+
+    split_shared_memory_lock();
+    memcpy(&split_shmem->rpc_async_response, &response, sizeof(response));
+    split_shared_memory_unlock();
+}
+
+// clang-format off
+#    define TRANSACTIONS_RPC_ASYNC_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(rpc_async, SPLIT_PRIORITY_STATE)
+#    define TRANSACTIONS_RPC_ASYNC_SLAVE() TRANSACTION_HANDLER_SLAVE(rpc_async)
+#    define TRANSACTIONS_RPC_ASYNC_REGISTRATIONS \
+    [PUT_RPC_ASYNC_REQUEST]  = { sizeof_member(split_shared_memory_t, rpc_async_request), offsetof(split_shared_memory_t, rpc_async_request), sizeof_member(split_shared_memory_t, rpc_async_response), offsetof(split_shared_memory_t, rpc_async_response), NULL }, \
+    [GET_RPC_ASYNC_RESPONSE] = trans_target2initiator_initializer(rpc_async_response),
+// clang-format on
+
+#else // (defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)) && defined(SPLIT_TRANSACTIONS_ASYNC_RPC)
+
+#    define TRANSACTIONS_RPC_ASYNC_MASTER()
+#    define TRANSACTIONS_RPC_ASYNC_SLAVE()
+#    define TRANSACTIONS_RPC_ASYNC_REGISTRATIONS
+
+#endif // (defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)) && defined(SPLIT_TRANSACTIONS_ASYNC_RPC)
+
 ////////////////////////////////////////////////////
 
 split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
@@ -895,6 +1347,7 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
 #endif // USE_I2C
 
     // clang-format off
+    TRANSACTIONS_BATCH_REGISTRATIONS
     TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS
     TRANSACTIONS_MASTER_MATRIX_REGISTRATIONS
     TRANSACTIONS_ENCODERS_REGISTRATIONS
@@ -906,6 +1359,7 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
     TRANSACTIONS_RGBLIGHT_REGISTRATIONS
     TRANSACTIONS_LED_MATRIX_REGISTRATIONS
     TRANSACTIONS_RGB_MATRIX_REGISTRATIONS
+    TRANSACTIONS_RGB_MATRIX_COLORS_REGISTRATIONS
     TRANSACTIONS_WPM_REGISTRATIONS
     TRANSACTIONS_OLED_REGISTRATIONS
     TRANSACTIONS_ST7565_REGISTRATIONS
@@ -914,6 +1368,7 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
     TRANSACTIONS_HAPTIC_REGISTRATIONS
     TRANSACTIONS_ACTIVITY_REGISTRATIONS
     TRANSACTIONS_DETECTED_OS_REGISTRATIONS
+    TRANSACTIONS_RPC_ASYNC_REGISTRATIONS
 // clang-format on
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
@@ -925,29 +1380,50 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
 };
 
 bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+#ifdef SPLIT_TRANSACTIONS_SCHEDULED
+    scheduler_refill();
+#endif // SPLIT_TRANSACTIONS_SCHEDULED
+    TRANSACTIONS_BATCH_MASTER();
     TRANSACTIONS_SLAVE_MATRIX_MASTER();
     TRANSACTIONS_MASTER_MATRIX_MASTER();
     TRANSACTIONS_ENCODERS_MASTER();
+#ifdef SPLIT_TRANSACTIONS_SCHEDULED
+    // Input first, then state, then cosmetics
+    TRANSACTIONS_POINTING_MASTER();
+#endif // SPLIT_TRANSACTIONS_SCHEDULED
     TRANSACTIONS_SYNC_TIMER_MASTER();
     TRANSACTIONS_LAYER_STATE_MASTER();
     TRANSACTIONS_LED_STATE_MASTER();
     TRANSACTIONS_MODS_MASTER();
+#ifdef SPLIT_TRANSACTIONS_SCHEDULED
+    TRANSACTIONS_WATCHDOG_MASTER();
+    TRANSACTIONS_HAPTIC_MASTER();
+    TRANSACTIONS_DETECTED_OS_MASTER();
+    TRANSACTIONS_RPC_ASYNC_MASTER();
+#endif // SPLIT_TRANSACTIONS_SCHEDULED
     TRANSACTIONS_BACKLIGHT_MASTER();
     TRANSACTIONS_RGBLIGHT_MASTER();
     TRANSACTIONS_LED_MATRIX_MASTER();
     TRANSACTIONS_RGB_MATRIX_MASTER();
+    TRANSACTIONS_RGB_MATRIX_COLORS_MASTER();
     TRANSACTIONS_WPM_MASTER();
     TRANSACTIONS_OLED_MASTER();
     TRANSACTIONS_ST7565_MASTER();
+#ifndef SPLIT_TRANSACTIONS_SCHEDULED
     TRANSACTIONS_POINTING_MASTER();
     TRANSACTIONS_WATCHDOG_MASTER();
     TRANSACTIONS_HAPTIC_MASTER();
+#endif // SPLIT_TRANSACTIONS_SCHEDULED
     TRANSACTIONS_ACTIVITY_MASTER();
+#ifndef SPLIT_TRANSACTIONS_SCHEDULED
     TRANSACTIONS_DETECTED_OS_MASTER();
+    TRANSACTIONS_RPC_ASYNC_MASTER();
+#endif // SPLIT_TRANSACTIONS_SCHEDULED
     return true;
 }
 
 void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    TRANSACTIONS_BATCH_SLAVE();
     TRANSACTIONS_SLAVE_MATRIX_SLAVE();
     TRANSACTIONS_MASTER_MATRIX_SLAVE();
     TRANSACTIONS_ENCODERS_SLAVE();
@@ -959,6 +1435,7 @@ void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[
     TRANSACTIONS_RGBLIGHT_SLAVE();
     TRANSACTIONS_LED_MATRIX_SLAVE();
     TRANSACTIONS_RGB_MATRIX_SLAVE();
+    TRANSACTIONS_RGB_MATRIX_COLORS_SLAVE();
     TRANSACTIONS_WPM_SLAVE();
     TRANSACTIONS_OLED_SLAVE();
     TRANSACTIONS_ST7565_SLAVE();
@@ -967,6 +1444,8 @@ void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[
     TRANSACTIONS_HAPTIC_SLAVE();
     TRANSACTIONS_ACTIVITY_SLAVE();
     TRANSACTIONS_DETECTED_OS_SLAVE();
+    TRANSACTIONS_RPC_ASYNC_SLAVE();
+    TRANSACTIONS_BATCH_REPLY_SLAVE();
 }
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -41,13 +42,46 @@ extern split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS];
 #define split_trans_initiator2target_buffer(trans) (split_shmem_offset_ptr((trans)->initiator2target_offset))
 #define split_trans_target2initiator_buffer(trans) (split_shmem_offset_ptr((trans)->target2initiator_offset))
 
+#ifdef SPLIT_TRANSACTIONS_BATCHED
+// A batch frame only goes out as far as its length, so the target takes the header first and then the rest
+static inline uint8_t split_trans_initiator2target_header(int8_t id, const split_transaction_desc_t *trans) {
+    return id == PUT_BATCH_FRAME ? offsetof(split_batch_frame_t, data) : trans->initiator2target_buffer_size;
+}
+
+// Bytes the initiator sends once the header is in the buffer, 0 if the header asks for more than fits
+static inline uint8_t split_trans_initiator2target_length(int8_t id, const split_transaction_desc_t *trans, const void *buffer) {
+    if (id != PUT_BATCH_FRAME) {
+        return trans->initiator2target_buffer_size;
+    }
+    uint8_t length = ((const split_batch_frame_t *)buffer)->length;
+    return length <= SPLIT_BATCH_FRAME_SIZE ? offsetof(split_batch_frame_t, data) + length : 0;
+}
+#else
+#    define split_trans_initiator2target_header(id, trans) ((trans)->initiator2target_buffer_size)
+#    define split_trans_initiator2target_length(id, trans, buffer) ((trans)->initiator2target_buffer_size)
+#endif // SPLIT_TRANSACTIONS_BATCHED
+
 // returns false if valid data not received from slave
 bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 
 void transaction_register_rpc(int8_t transaction_id, slave_callback_t callback);
 
+#ifdef SPLIT_TRANSACTIONS_SCHEDULED
+// charges a transfer of this many bytes to the scheduler's per-scan budget
+void transactions_scheduler_charge(uint16_t bytes);
+#endif // SPLIT_TRANSACTIONS_SCHEDULED
+
 bool transaction_rpc_exec(int8_t transaction_id, uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
 
 #define transaction_rpc_send(transaction_id, initiator2target_buffer_size, initiator2target_buffer) transaction_rpc_exec(transaction_id, initiator2target_buffer_size, initiator2target_buffer, 0, NULL)
 #define transaction_rpc_recv(transaction_id, target2initiator_buffer_size, target2initiator_buffer) transaction_rpc_exec(transaction_id, 0, NULL, target2initiator_buffer_size, target2initiator_buffer)
+
+#ifdef SPLIT_TRANSACTIONS_ASYNC_RPC
+typedef void (*rpc_async_callback_t)(int8_t transaction_id, bool success, uint8_t target2initiator_buffer_size, const void *target2initiator_buffer, void *cb_arg);
+
+// queues the call and returns straight away; the callback, if any, runs from a later transactions_master()
+bool transaction_rpc_exec_async(int8_t transaction_id, uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, rpc_async_callback_t callback, void *cb_arg);
+
+#    define transaction_rpc_send_async(transaction_id, initiator2target_buffer_size, initiator2target_buffer) transaction_rpc_exec_async(transaction_id, initiator2target_buffer_size, initiator2target_buffer, 0, NULL, NULL)
+#endif // SPLIT_TRANSACTIONS_ASYNC_RPC
@@ -93,6 +93,13 @@ typedef struct _rgb_matrix_sync_t {
     rgb_config_t rgb_matrix;
     bool         rgb_suspend_state;
 } rgb_matrix_sync_t;
+
+#    ifdef SPLIT_RGB_MATRIX_COLORS_ENABLE
+typedef struct _rgb_matrix_colors_sync_t {
+    uint8_t                  count;
+    rgb_matrix_split_color_t colors[RGB_MATRIX_SPLIT_COLORS_PER_SYNC];
+} rgb_matrix_colors_sync_t;
+#    endif // SPLIT_RGB_MATRIX_COLORS_ENABLE
 #endif // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 
 #ifdef SPLIT_MODS_ENABLE
@@ -140,12 +147,76 @@ typedef struct _rpc_sync_info_t {
         uint8_t s2m_length;
     } payload;
 } rpc_sync_info_t;
+
+#    ifdef SPLIT_TRANSACTIONS_ASYNC_RPC
+#        ifndef SPLIT_RPC_ASYNC_QUEUE_SIZE
+#            define SPLIT_RPC_ASYNC_QUEUE_SIZE 4
+#        endif // SPLIT_RPC_ASYNC_QUEUE_SIZE
+
+#        ifndef SPLIT_RPC_ASYNC_RESEND_MS
+#            define SPLIT_RPC_ASYNC_RESEND_MS 20
+#        endif // SPLIT_RPC_ASYNC_RESEND_MS
+
+#        ifndef SPLIT_RPC_ASYNC_ATTEMPTS
+#            define SPLIT_RPC_ASYNC_ATTEMPTS 5
+#        endif // SPLIT_RPC_ASYNC_ATTEMPTS
+
+// Master to slave: the info, request data and execute steps of an RPC in one block
+typedef struct _split_rpc_async_request_t {
+    uint8_t checksum;
+    uint8_t seq;
+    int8_t  transaction_id;
+    uint8_t m2s_length;
+    uint8_t s2m_length;
+    uint8_t data[RPC_M2S_BUFFER_SIZE];
+} split_rpc_async_request_t;
+
+// Slave to master: the response to the request with the same sequence number
+typedef struct _split_rpc_async_response_t {
+    uint8_t checksum;
+    uint8_t seq;
+    uint8_t length;
+    uint8_t data[RPC_S2M_BUFFER_SIZE];
+} split_rpc_async_response_t;
+#    endif // SPLIT_TRANSACTIONS_ASYNC_RPC
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 
 #if defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
 #    include "os_detection.h"
 #endif // defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
 
+#ifdef SPLIT_TRANSACTIONS_BATCHED
+#    ifndef SPLIT_BATCH_FRAME_SIZE
+#        define SPLIT_BATCH_FRAME_SIZE 48
+#    endif // SPLIT_BATCH_FRAME_SIZE
+
+#    ifndef SPLIT_BATCH_RESEND_MS
+#        define SPLIT_BATCH_RESEND_MS 10
+#    endif // SPLIT_BATCH_RESEND_MS
+
+// Master to slave: `length` bytes of entries, each a transaction ID, a payload length and the payload
+typedef struct _split_batch_frame_t {
+    uint8_t checksum;
+    uint8_t seq;
+    uint8_t length;
+    uint8_t data[SPLIT_BATCH_FRAME_SIZE];
+} split_batch_frame_t;
+
+// Slave to master: everything the master reads each scan, and the last frame the slave applied
+typedef struct _split_batch_reply_t {
+    uint8_t                   checksum;
+    uint8_t                   applied_seq;
+    split_slave_matrix_sync_t smatrix;
+#    ifdef ENCODER_ENABLE
+    split_slave_encoder_sync_t encoders;
+#    endif // ENCODER_ENABLE
+#    if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+    uint8_t        pointing_checksum;
+    report_mouse_t pointing_report;
+#    endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+} split_batch_reply_t;
+#endif // SPLIT_TRANSACTIONS_BATCHED
+
 typedef struct _split_shared_memory_t {
 #ifdef USE_I2C
     int8_t transaction_id;
@@ -191,6 +262,9 @@ typedef struct _split_shared_memory_t {
 
 #if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
     rgb_matrix_sync_t rgb_matrix_sync;
+#    ifdef SPLIT_RGB_MATRIX_COLORS_ENABLE
+    rgb_matrix_colors_sync_t rgb_matrix_colors_sync;
+#    endif // SPLIT_RGB_MATRIX_COLORS_ENABLE
 #endif // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 
 #if defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)
@@ -225,11 +299,20 @@ typedef struct _split_shared_memory_t {
     rpc_sync_info_t rpc_info;
     uint8_t         rpc_m2s_buffer[RPC_M2S_BUFFER_SIZE];
     uint8_t         rpc_s2m_buffer[RPC_S2M_BUFFER_SIZE];
+#    ifdef SPLIT_TRANSACTIONS_ASYNC_RPC
+    split_rpc_async_request_t  rpc_async_request;
+    split_rpc_async_response_t rpc_async_response;
+#    endif // SPLIT_TRANSACTIONS_ASYNC_RPC
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 
 #if defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
     os_variant_t detected_os;
 #endif // defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
+
+#ifdef SPLIT_TRANSACTIONS_BATCHED
+    split_batch_frame_t batch_frame;
+    split_batch_reply_t batch_reply;
+#endif // SPLIT_TRANSACTIONS_BATCHED
 } split_shared_memory_t;
 
 extern split_shared_memory_t *const split_shmem;
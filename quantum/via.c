@@ -136,6 +136,8 @@ void via_init(void) {
     if (!via_eeprom_is_valid()) {
         eeconfig_init_via();
     }
+
+    dynamic_keymap_init();
 }
 
 void eeconfig_init_via(void) {
@@ -222,6 +224,12 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
     }
 #endif
 
+#if defined(VIALRGB_ENABLE)
+    /* Streamed direct mode frames are fire-and-forget, replying would halve the rate they can be sent at */
+    if (vialrgb_handle_stream(data, length))
+        return;
+#endif
+
     switch (*command_id) {
         case id_get_protocol_version: {
             command_data[0] = VIA_PROTOCOL_VERSION >> 8;
@@ -17,9 +17,12 @@
 #include "vial.h"
 
 #include <string.h>
+#include <stddef.h>
 
 #include "dynamic_keymap.h"
 #include "quantum.h"
+#include "raw_hid.h"
+#include "vial_bulk.h"
 #include "vial_generated_keyboard_definition.h"
 
 #include "vial_ensure_keycode.h"
@@ -46,6 +49,15 @@ _Static_assert(sizeof(vial_unlock_combo_rows) == sizeof(vial_unlock_combo_cols),
 
 #include "qmk_settings.h"
 
+#ifdef SCAN_PROFILE_ENABLE
+#include "scan_profile.h"
+#endif
+
+#ifdef SPLIT_TELEMETRY_ENABLE
+#include "split_telemetry.h"
+#include "transaction_id_define.h"
+#endif
+
 #ifdef VIAL_TAP_DANCE_ENABLE
 static void reload_tap_dance(void);
 #endif
@@ -76,11 +88,34 @@ __attribute__((unused)) static uint16_t vial_keycode_firewall(uint16_t in) {
     return in;
 }
 
+static struct {
+    bool active;
+    uint8_t seq;
+    vial_bulk_cursor_t cursor;
+} bulk_read;
+
+void vial_task(void) {
+    if (!bulk_read.active)
+        return;
+
+    uint8_t packet[VIAL_RAW_EPSIZE] = { 0 };
+    packet[0] = bulk_read.seq++;
+    vial_bulk_encode(&bulk_read.cursor, &packet[2], sizeof(packet) - 2);
+    if (bulk_read.cursor.pos >= bulk_read.cursor.end) {
+        packet[1] |= VIAL_BULK_PACKET_LAST;
+        bulk_read.active = false;
+    }
+    raw_hid_send(packet, sizeof(packet));
+}
+
 void vial_handle_cmd(uint8_t *msg, uint8_t length) {
     /* All packets must be fixed 32 bytes */
     if (length != VIAL_RAW_EPSIZE)
         return;
 
+    /* a new request from the host always ends a pending keymap stream */
+    bulk_read.active = false;
+
     /* msg[0] is 0xFE -- prefix vial magic */
     switch (msg[1]) {
         /* Get keyboard ID and Vial protocol version */
@@ -287,6 +322,124 @@ void vial_handle_cmd(uint8_t *msg, uint8_t length) {
 
             break;
         }
+        case vial_keymap_bulk_read: {
+            uint16_t key_count = dynamic_keymap_get_key_count();
+            uint16_t start = msg[2] | (msg[3] << 8);
+            uint16_t count = msg[4] | (msg[5] << 8);
+            if (start > key_count)
+                start = key_count;
+            if (count == 0 || count > key_count - start)
+                count = key_count - start;
+
+            bulk_read.cursor.pos = start;
+            bulk_read.cursor.end = start + count;
+            bulk_read.cursor.fill = msg[6] | (msg[7] << 8);
+            bulk_read.seq = 0;
+            bulk_read.active = count > 0;
+
+            memset(msg, 0, length);
+            msg[1] = count & 0xFF;
+            msg[2] = count >> 8;
+            break;
+        }
+        case vial_keymap_bulk_write: {
+            uint16_t written = vial_bulk_decode(msg[2] | (msg[3] << 8), msg[4] | (msg[5] << 8), &msg[6], length - 6, vial_keycode_firewall);
+            memset(msg, 0, length);
+            msg[1] = written & 0xFF;
+            msg[2] = written >> 8;
+            break;
+        }
+        case vial_scan_profile_op: {
+#ifdef SCAN_PROFILE_ENABLE
+            switch (msg[2]) {
+            case vial_scan_profile_get_info: {
+                uint32_t freq = scan_profile_tick_frequency();
+                memset(msg, 0, length);
+                msg[1] = SCAN_PROFILE_STAGE_COUNT;
+                msg[2] = SCAN_PROFILE_HISTOGRAM_BUCKETS;
+                msg[3] = SCAN_PROFILE_HISTOGRAM_SUB_BITS;
+                memcpy(&msg[4], &freq, sizeof(freq));
+                break;
+            }
+            case vial_scan_profile_get_stats: {
+                scan_profile_stats_t stats;
+                msg[0] = scan_profile_get_stats(msg[3], &stats) ? 0 : 1;
+                memcpy(&msg[1], &stats, sizeof(stats));
+                break;
+            }
+            case vial_scan_profile_get_histogram: {
+                /* up to 15 buckets per packet starting at msg[4]; unused entries are 0 */
+                uint8_t stage = msg[3];
+                uint8_t first = msg[4];
+                memset(msg, 0, length);
+                msg[0] = stage < SCAN_PROFILE_STAGE_COUNT ? 0 : 1;
+                for (size_t i = 0; i < (length - 2) / 2 && first + i < SCAN_PROFILE_HISTOGRAM_BUCKETS; ++i) {
+                    uint16_t count = scan_profile_get_histogram_bucket(stage, first + i);
+                    memcpy(&msg[2 + i * 2], &count, sizeof(count));
+                }
+                break;
+            }
+            case vial_scan_profile_reset: {
+                scan_profile_reset();
+                msg[0] = 0;
+                break;
+            }
+            }
+#else
+            memset(msg, 0xFF, length); /* indicate that profiling is not compiled in */
+#endif
+            break;
+        }
+        case vial_split_telemetry_op: {
+#ifdef SPLIT_TELEMETRY_ENABLE
+            switch (msg[2]) {
+            case vial_split_telemetry_get_info: {
+                uint8_t buckets = split_telemetry_rtt_buckets();
+                memset(msg, 0, length);
+                msg[1] = NUM_TOTAL_TRANSACTIONS;
+                msg[2] = buckets;
+                for (size_t i = 0; i < (length - 4) / 2 && i + 1 < buckets; ++i) {
+                    uint16_t bound = split_telemetry_rtt_bound(i);
+                    memcpy(&msg[4 + i * 2], &bound, sizeof(bound));
+                }
+                break;
+            }
+            case vial_split_telemetry_get_counters:
+            case vial_split_telemetry_get_rtt: {
+                /* the whole struct does not fit a packet, so it is read in two halves */
+                split_telemetry_stats_t stats;
+                uint8_t op = msg[2];
+                bool okay = split_telemetry_get_stats(msg[3], &stats);
+                memset(msg, 0, length);
+                msg[0] = okay ? 0 : 1;
+                if (op == vial_split_telemetry_get_counters)
+                    memcpy(&msg[1], &stats, offsetof(split_telemetry_stats_t, rtt_min_us));
+                else
+                    memcpy(&msg[1], &stats.rtt_min_us, sizeof(stats) - offsetof(split_telemetry_stats_t, rtt_min_us));
+                break;
+            }
+            case vial_split_telemetry_get_histogram: {
+                int8_t id = msg[3];
+                uint8_t first = msg[4];
+                memset(msg, 0, length);
+                msg[0] = id >= 0 && id < NUM_TOTAL_TRANSACTIONS ? 0 : 1;
+                for (size_t i = 0; i < (length - 2) / 2 && first + i < split_telemetry_rtt_buckets(); ++i) {
+                    uint16_t count = split_telemetry_get_histogram_bucket(id, first + i);
+                    memcpy(&msg[2 + i * 2], &count, sizeof(count));
+                }
+                break;
+            }
+            case vial_split_telemetry_reset: {
+                split_telemetry_reset();
+                msg[0] = 0;
+                break;
+            }
+            }
+#else
+            memset(msg, 0xFF, length); /* indicate that telemetry is not compiled in */
+#endif
+            break;
+        }
     }
 }
 
@@ -525,6 +678,10 @@ static void reload_combo(void) {
             key_combos[i].keycode = entry.output;
         }
     }
+
+#ifdef COMBO_KEY_INDEX
+    combo_key_index_rebuild();
+#endif
 }
 #endif
 
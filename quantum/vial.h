@@ -26,6 +26,7 @@
 #define VIAL_RAW_EPSIZE 32
 
 void vial_init(void);
+void vial_task(void);
 void vial_handle_cmd(uint8_t *data, uint8_t length);
 bool process_record_vial(uint16_t keycode, keyrecord_t *record);
 
@@ -48,8 +49,32 @@ enum {
     vial_qmk_settings_set = 0x0B,
     vial_qmk_settings_reset = 0x0C,
     vial_dynamic_entry_op = 0x0D,  /* operate on tapdance, combos, etc */
+    vial_scan_profile_op = 0x0E,  /* read keyboard_task per-stage timing, see scan_profile.h */
+    vial_keymap_bulk_read = 0x0F,  /* stream the keymap, see below */
+    vial_keymap_bulk_write = 0x10,
+    vial_split_telemetry_op = 0x11,  /* read split transport statistics, see split_telemetry.h */
 };
 
+/* Bulk keymap transfer
+
+   Keycodes are addressed by linear key index (layer * MATRIX_ROWS * MATRIX_COLS + row * MATRIX_COLS + col)
+   and run-length encoded as a list of records:
+       [skip] [n] [n big-endian keycodes]
+   where skip is the number of consecutive keys equal to the "fill" keycode chosen by the host (e.g. KC_TRNS),
+   followed by n literal keycodes. A record with skip == 0 and n == 0 ends the list.
+
+   vial_keymap_bulk_read: msg[2..3] = first key index, msg[4..5] = number of keys (0 = until the end),
+   msg[6..7] = fill keycode. The reply carries msg[0] = 0 and msg[1..2] = the number of keys that will be sent.
+   The keyboard then sends packets on its own until done, without further requests:
+       [sequence number] [flags] [records...]
+   with VIAL_BULK_PACKET_LAST set in flags on the final packet. Any other Vial command aborts the stream.
+
+   vial_keymap_bulk_write: msg[2..3] = first key index, msg[4..5] = fill keycode, msg[6..31] = records.
+   The reply carries msg[0] = 0 and msg[1..2] = the number of keys written; keys past the end of the keymap are
+   dropped and not counted. All multi-byte fields other than
+   keycodes inside records are little-endian. */
+#define VIAL_BULK_PACKET_LAST (1 << 0)
+
 enum {
     dynamic_vial_get_number_of_entries = 0x00,
     dynamic_vial_tap_dance_get = 0x01,
@@ -60,6 +85,29 @@ enum {
     dynamic_vial_key_override_set = 0x06,
 };
 
+enum {
+    vial_scan_profile_get_info = 0x00,
+    vial_scan_profile_get_stats = 0x01,
+    vial_scan_profile_get_histogram = 0x02,
+    vial_scan_profile_reset = 0x03,
+};
+
+/* Split telemetry, msg[3] = transaction ID where one is needed
+
+   get_info: msg[1] = number of transaction IDs, msg[2] = number of RTT buckets,
+   msg[4..] = the upper bound in microseconds of each bucket but the last.
+   get_counters: msg[1..28] = the seven 32-bit counters of split_telemetry_stats_t.
+   get_rtt: msg[1..6] = rtt_min_us, rtt_max_us, rtt_avg_us.
+   get_histogram: msg[4] = first bucket, reply msg[2..] = up to 15 bucket counts.
+   msg[0] is 0 on success, and every byte is 0xFF if telemetry is not compiled in. */
+enum {
+    vial_split_telemetry_get_info = 0x00,
+    vial_split_telemetry_get_counters = 0x01,
+    vial_split_telemetry_get_rtt = 0x02,
+    vial_split_telemetry_get_histogram = 0x03,
+    vial_split_telemetry_reset = 0x04,
+};
+
 #define VIAL_MACRO_EXT_TAP 5
 #define VIAL_MACRO_EXT_DOWN 6
 #define VIAL_MACRO_EXT_UP 7
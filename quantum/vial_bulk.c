@@ -0,0 +1,96 @@
+/* Copyright 2024 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "vial_bulk.h"
+
+#include "dynamic_keymap.h"
+#include "util.h"
+
+/* Keycodes are written to the keymap this many at a time */
+#define VIAL_BULK_CHUNK 16
+
+static uint16_t vial_bulk_keycode_at(uint16_t index) {
+    uint16_t keycode;
+    dynamic_keymap_get_keycodes(index, 1, &keycode);
+    return keycode;
+}
+
+void vial_bulk_encode(vial_bulk_cursor_t *cursor, uint8_t *out, uint8_t size) {
+    uint8_t used = 0;
+    while (cursor->pos < cursor->end && size - used >= 2) {
+        uint8_t skip = 0;
+        while (cursor->pos < cursor->end && skip < 0xFF && vial_bulk_keycode_at(cursor->pos) == cursor->fill) {
+            ++skip;
+            ++cursor->pos;
+        }
+
+        uint8_t max_literal = (size - used - 2) / 2;
+        uint8_t n = 0;
+        while (cursor->pos < cursor->end && n < max_literal) {
+            uint16_t keycode = vial_bulk_keycode_at(cursor->pos);
+            if (keycode == cursor->fill)
+                break;
+            out[used + 2 + n * 2] = keycode >> 8;
+            out[used + 2 + n * 2 + 1] = keycode & 0xFF;
+            ++n;
+            ++cursor->pos;
+        }
+
+        if (skip == 0 && n == 0)
+            break;
+        out[used] = skip;
+        out[used + 1] = n;
+        used += 2 + n * 2;
+    }
+}
+
+uint16_t vial_bulk_decode(uint16_t index, uint16_t fill, const uint8_t *in, uint8_t size, vial_bulk_filter_t filter) {
+    uint16_t key_count = dynamic_keymap_get_key_count();
+    uint16_t keycodes[VIAL_BULK_CHUNK];
+    uint16_t written = 0;
+    uint8_t used = 0;
+
+    if (index >= key_count)
+        return 0;
+
+    fill = filter(fill);
+    while (size - used >= 2) {
+        uint8_t skip = in[used];
+        uint8_t n = in[used + 1];
+        if ((skip == 0 && n == 0) || 2 + n * 2 > size - used)
+            break;
+        const uint8_t *literals = &in[used + 2];
+        used += 2 + n * 2;
+
+        /* index stays below key_count, so it can't wrap around to the start of the keymap */
+        uint16_t total = skip + n;
+        for (uint16_t i = 0; i < total;) {
+            uint16_t chunk = MIN(MIN(total - i, VIAL_BULK_CHUNK), key_count - index);
+            for (uint16_t j = 0; j < chunk; j++) {
+                uint16_t k = i + j;
+                keycodes[j] = k < skip ? fill : filter((literals[(k - skip) * 2] << 8) | literals[(k - skip) * 2 + 1]);
+            }
+            dynamic_keymap_set_keycodes(index, chunk, keycodes);
+            index += chunk;
+            written += chunk;
+            i += chunk;
+            if (index >= key_count)
+                return written;
+        }
+    }
+
+    return written;
+}
@@ -0,0 +1,38 @@
+/* Copyright 2024 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <inttypes.h>
+
+/* Run-length coding of the dynamic keymap for vial_keymap_bulk_read and vial_keymap_bulk_write,
+   see vial.h for the record format */
+
+typedef struct {
+    uint16_t pos;
+    uint16_t end;
+    uint16_t fill;
+} vial_bulk_cursor_t;
+
+/* Applied to every keycode before it is written */
+typedef uint16_t (*vial_bulk_filter_t)(uint16_t keycode);
+
+/* Encode as many records as fit in size bytes, advancing cursor->pos */
+void vial_bulk_encode(vial_bulk_cursor_t *cursor, uint8_t *out, uint8_t size);
+
+/* Decode records from in, writing keycodes starting at index. Keys past the end of the keymap
+   are dropped. Returns the number of keys actually written. */
+uint16_t vial_bulk_decode(uint16_t index, uint16_t fill, const uint8_t *in, uint8_t size, vial_bulk_filter_t filter);
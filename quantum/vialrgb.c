@@ -7,6 +7,7 @@
 #include <string.h>
 #include "rgb_matrix.h"
 #include "vial.h"
+#include "via.h"
 
 typedef struct {
     uint16_t vialrgb_id;
@@ -19,6 +20,23 @@ typedef struct {
 
 #ifdef RGB_MATRIX_EFFECT_VIALRGB_DIRECT
 HSV g_direct_mode_colors[RGB_MATRIX_LED_COUNT];
+
+#ifdef VIALRGB_DIRECT_STREAM
+/* Streamed frames in RGB565: the one being shown, the newest complete one waiting to be shown and the one being received */
+static uint16_t stream_frames[3][RGB_MATRIX_LED_COUNT];
+static uint8_t stream_shown = 0, stream_ready = 1, stream_receiving = 2;
+static bool stream_ready_new;
+static bool stream_active;
+static uint16_t stream_palette[VIALRGB_STREAM_PALETTE_SIZE];
+
+#define STREAM_IDLE 0
+#define STREAM_DROPPING 0xFF
+static uint8_t stream_seq;
+static uint8_t stream_next_packet = STREAM_IDLE;
+static uint8_t stream_last_seq;
+static uint16_t stream_frames_completed;
+static uint16_t stream_frames_dropped;
+#endif
 #endif
 
 static void get_supported(uint8_t *args, uint8_t length) {
@@ -107,6 +125,110 @@ static void fast_set_leds(uint8_t *args, size_t length) {
         uint8_t val = args[i * 3 + 2];
         g_direct_mode_colors[i + first_index].v = (val > RGB_MATRIX_MAXIMUM_BRIGHTNESS) ? RGB_MATRIX_MAXIMUM_BRIGHTNESS : val;
     }
+#ifdef VIALRGB_DIRECT_STREAM
+    stream_active = false;
+#endif
+}
+#endif
+
+#if defined(RGB_MATRIX_EFFECT_VIALRGB_DIRECT) && defined(VIALRGB_DIRECT_STREAM)
+static void set_palette(uint8_t *args) {
+    uint8_t first = args[0];
+    uint8_t count = args[1];
+    if (count > 8) return;
+
+    for (uint8_t i = 0; i < count && first + i < VIALRGB_STREAM_PALETTE_SIZE; ++i) {
+        uint8_t *rgb = &args[2 + i * 3];
+        stream_palette[first + i] = ((rgb[0] & 0xF8) << 8) | ((rgb[1] & 0xFC) << 3) | (rgb[2] >> 3);
+    }
+}
+
+static void stream_decode(uint8_t encoding, uint16_t led, uint8_t count, const uint8_t *payload) {
+    uint16_t *frame = stream_frames[stream_receiving];
+
+    switch (encoding) {
+    case VIALRGB_STREAM_RGB565:
+        for (uint8_t i = 0; i < count && i < 12 && led < RGB_MATRIX_LED_COUNT; ++i, ++led)
+            frame[led] = payload[i * 2] | (payload[i * 2 + 1] << 8);
+        break;
+    case VIALRGB_STREAM_PALETTE:
+        for (uint8_t i = 0; i < count && i < 48 && led < RGB_MATRIX_LED_COUNT; ++i, ++led)
+            frame[led] = stream_palette[(i & 1) ? payload[i / 2] >> 4 : payload[i / 2] & 0x0F];
+        break;
+    case VIALRGB_STREAM_DELTA:
+        for (uint8_t i = 0; i < count && i < 8; ++i) {
+            led += payload[i * 3];
+            if (led >= RGB_MATRIX_LED_COUNT)
+                break;
+            frame[led++] = payload[i * 3 + 1] | (payload[i * 3 + 2] << 8);
+        }
+        break;
+    }
+}
+
+bool vialrgb_handle_stream(uint8_t *data, uint8_t length) {
+    if (length != VIAL_RAW_EPSIZE || data[0] != id_lighting_set_value || data[1] != vialrgb_direct_stream)
+        return false;
+
+    uint8_t seq = data[2];
+    uint8_t index = data[3];
+    uint8_t flags = data[4];
+
+    if (index == 0 || seq != stream_seq) {
+        /* a new frame starts, from the newest complete one so that delta and partial updates have a base */
+        if (stream_next_packet != STREAM_IDLE && stream_next_packet != STREAM_DROPPING)
+            stream_frames_dropped++;
+        stream_seq = seq;
+        stream_next_packet = 0;
+        memcpy(stream_frames[stream_receiving], stream_frames[stream_ready_new ? stream_ready : stream_shown], sizeof(stream_frames[0]));
+    }
+
+    if (index != stream_next_packet) {
+        /* a packet went missing, the rest of the frame is useless */
+        if (stream_next_packet != STREAM_DROPPING)
+            stream_frames_dropped++;
+        stream_next_packet = STREAM_DROPPING;
+        return true;
+    }
+
+    stream_decode(flags & VIALRGB_STREAM_ENCODING_MASK, data[5] | (data[6] << 8), data[7], &data[8]);
+
+    if (flags & VIALRGB_STREAM_LAST) {
+        uint8_t complete = stream_receiving;
+        stream_receiving = stream_ready;
+        stream_ready = complete;
+        stream_ready_new = true;
+        stream_active = true;
+        stream_last_seq = seq;
+        stream_frames_completed++;
+        stream_next_packet = STREAM_IDLE;
+    } else {
+        stream_next_packet++;
+    }
+    return true;
+}
+
+const uint16_t *vialrgb_direct_stream_frame(void) {
+    if (!stream_active)
+        return NULL;
+    if (stream_ready_new) {
+        uint8_t shown = stream_ready;
+        stream_ready = stream_shown;
+        stream_shown = shown;
+        stream_ready_new = false;
+    }
+    return stream_frames[stream_shown];
+}
+
+void vialrgb_direct_stream_stop(void) {
+    stream_active = false;
+}
+#else
+bool vialrgb_handle_stream(uint8_t *data, uint8_t length) {
+    (void)data;
+    (void)length;
+
+    return false;
 }
 #endif
 
@@ -121,6 +243,11 @@ void vialrgb_get_value(uint8_t *data, uint8_t length) {
         args[0] = VIALRGB_PROTOCOL_VERSION & 0xFF;
         args[1] = VIALRGB_PROTOCOL_VERSION >> 8;
         args[2] = RGB_MATRIX_MAXIMUM_BRIGHTNESS;
+#if defined(RGB_MATRIX_EFFECT_VIALRGB_DIRECT) && defined(VIALRGB_DIRECT_STREAM)
+        args[3] = VIALRGB_CAP_DIRECT_STREAM;
+#else
+        args[3] = 0;
+#endif
         break;
     case vialrgb_get_mode: {
         uint16_t vialrgb_id = get_mode();
@@ -154,6 +281,16 @@ void vialrgb_get_value(uint8_t *data, uint8_t length) {
         get_matrix_pos_for_led(led, &args[3]);
         break;
     }
+#ifdef VIALRGB_DIRECT_STREAM
+    case vialrgb_get_stream_status: {
+        args[0] = stream_last_seq;
+        args[1] = stream_frames_completed & 0xFF;
+        args[2] = stream_frames_completed >> 8;
+        args[3] = stream_frames_dropped & 0xFF;
+        args[4] = stream_frames_dropped >> 8;
+        break;
+    }
+#endif
 #endif
     }
 }
@@ -177,6 +314,12 @@ void vialrgb_set_value(uint8_t *data, uint8_t length) {
         fast_set_leds(args, length);
         break;
     }
+#ifdef VIALRGB_DIRECT_STREAM
+    case vialrgb_direct_set_palette: {
+        set_palette(args);
+        break;
+    }
+#endif
 #endif
     }
 }
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <inttypes.h>
+#include <stdbool.h>
 
 #define VIALRGB_PROTOCOL_VERSION 1
 
@@ -11,6 +12,8 @@
 enum {
     vialrgb_set_mode = 0x41,
     vialrgb_direct_fastset = 0x42,
+    vialrgb_direct_stream = 0x43,  /* no reply, see below */
+    vialrgb_direct_set_palette = 0x44,
 };
 
 enum {
@@ -19,11 +22,48 @@ enum {
     vialrgb_get_supported = 0x42,
     vialrgb_get_number_leds = 0x43,
     vialrgb_get_led_info = 0x44,
+    vialrgb_get_stream_status = 0x45,
+};
+
+/* Capability flags, reported in the 4th byte of vialrgb_get_info */
+#define VIALRGB_CAP_DIRECT_STREAM (1 << 0)
+
+/* Direct mode streaming
+
+   Only with VIALRGB_DIRECT_STREAM defined, as the three frame buffers take 6 bytes of RAM per LED.
+   VIALRGB_CAP_DIRECT_STREAM tells the host whether it is available.
+
+   Frames are sent as a series of vialrgb_direct_stream packets which, unlike every other command, get no reply:
+       msg[2] frame sequence number, msg[3] packet index within the frame (starting at 0),
+       msg[4] encoding | VIALRGB_STREAM_LAST on the final packet of the frame,
+       msg[5..6] first LED (little-endian), msg[7] number of LEDs or records, msg[8..31] payload
+   Encodings:
+       VIALRGB_STREAM_RGB565   2 bytes per LED, little-endian 5-6-5 bits, 12 LEDs per packet
+       VIALRGB_STREAM_PALETTE  4 bits per LED indexing the palette, low nibble first, 48 LEDs per packet
+       VIALRGB_STREAM_DELTA    records of [skip] [RGB565], 8 per packet: leave `skip` LEDs as they were in the
+                               previous frame, then set the next one. LEDs not mentioned keep their previous color.
+   A frame is only shown once its last packet arrives, after all packets before it. Packets from a frame that
+   is missing one, or that is superseded by a different sequence number, are dropped along with the frame.
+   Completed frames are shown from the next rendered frame on, never partially.
+
+   vialrgb_direct_set_palette: msg[2] first entry, msg[3] count, msg[4..] RGB888 triplets, up to 8 per packet.
+   vialrgb_get_stream_status: msg[2] sequence number of the last complete frame, msg[3..4] frames completed,
+   msg[5..6] frames dropped (little-endian, wrapping), so the host can pace itself and notice losses.
+   vialrgb_direct_fastset, or selecting the direct effect again, switches back to the HSV colors set by fastset. */
+#define VIALRGB_STREAM_PALETTE_SIZE 16
+#define VIALRGB_STREAM_ENCODING_MASK 0x0F
+#define VIALRGB_STREAM_LAST (1 << 7)
+
+enum {
+    VIALRGB_STREAM_RGB565 = 0,
+    VIALRGB_STREAM_PALETTE = 1,
+    VIALRGB_STREAM_DELTA = 2,
 };
 
 void vialrgb_get_value(uint8_t *data, uint8_t length);
 void vialrgb_set_value(uint8_t *data, uint8_t length);
 void vialrgb_save(uint8_t *data, uint8_t length);
+bool vialrgb_handle_stream(uint8_t *data, uint8_t length);
 
 #if defined(VIALRGB_ENABLE) && !defined(RGB_MATRIX_ENABLE)
 #error VIALRGB_ENABLE=yes requires RGB_MATRIX_ENABLE=yes
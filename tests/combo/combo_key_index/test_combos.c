@@ -0,0 +1,19 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "quantum.h"
+
+enum combos { ab, abc, bd, e_duplicate };
+
+uint16_t const ab_combo[]          = {KC_A, KC_B, COMBO_END};
+uint16_t const abc_combo[]         = {KC_A, KC_B, KC_C, COMBO_END};
+uint16_t const bd_combo[]          = {KC_D, KC_B, COMBO_END};
+uint16_t const e_duplicate_combo[] = {KC_E, KC_E, COMBO_END};
+
+// clang-format off
+combo_t key_combos[] = {
+    [ab]          = COMBO(ab_combo, KC_X),
+    [abc]         = COMBO(abc_combo, KC_Y),
+    [bd]          = COMBO(bd_combo, KC_Z),
+    [e_duplicate] = COMBO(e_duplicate_combo, KC_W),
+};
+// clang-format on
@@ -0,0 +1,92 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "dynamic_keymap.h"
+#include "eeprom.h"
+#include "keymap_introspection.h"
+}
+
+// The cache build still needs the Vial stand-ins
+#include "vial_stubs.cpp"
+
+#ifndef DYNAMIC_KEYMAP_RAM_CACHE
+#    error "This build is meant to test the RAM cache"
+#endif
+
+namespace {
+
+// Reads a keycode from the big-endian EEPROM image, bypassing the cache
+uint16_t eeprom_keycode(uint8_t layer, uint8_t row, uint8_t column) {
+    uint8_t *address = (uint8_t *)dynamic_keymap_key_to_eeprom_address(layer, row, column);
+    return (eeprom_read_byte(address) << 8) | eeprom_read_byte(address + 1);
+}
+
+void write_eeprom_keycode(uint8_t layer, uint8_t row, uint8_t column, uint16_t keycode) {
+    uint8_t *address = (uint8_t *)dynamic_keymap_key_to_eeprom_address(layer, row, column);
+    eeprom_update_byte(address, keycode >> 8);
+    eeprom_update_byte(address + 1, keycode & 0xFF);
+}
+
+} // namespace
+
+class DynamicKeymapRamCache : public testing::Test {
+   protected:
+    void SetUp() override {
+        dynamic_keymap_reset();
+    }
+};
+
+TEST_F(DynamicKeymapRamCache, KeyboardInitLoadsTheCache) {
+    // Without VIA, nothing but keyboard_init() reads the keymap in
+    write_eeprom_keycode(0, 1, 2, KC_Q);
+    write_eeprom_keycode(1, MATRIX_ROWS - 1, MATRIX_COLS - 1, LT(1, KC_SPACE));
+    EXPECT_NE(dynamic_keymap_get_keycode(0, 1, 2), KC_Q);
+
+    keyboard_init();
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 1, 2), KC_Q);
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, MATRIX_ROWS - 1, MATRIX_COLS - 1), LT(1, KC_SPACE));
+}
+
+TEST_F(DynamicKeymapRamCache, SettersWriteThrough) {
+    dynamic_keymap_set_keycode(1, 0, 3, KC_Z);
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 0, 3), KC_Z);
+    EXPECT_EQ(eeprom_keycode(1, 0, 3), KC_Z);
+
+    uint16_t keycodes[] = {KC_A, KC_B, KC_C};
+    dynamic_keymap_set_keycodes(MATRIX_COLS, 3, keycodes);
+    for (uint8_t i = 0; i < 3; i++) {
+        EXPECT_EQ(dynamic_keymap_get_keycode(0, 1, i), keycodes[i]);
+        EXPECT_EQ(eeprom_keycode(0, 1, i), keycodes[i]);
+    }
+
+    // An odd offset only replaces the low byte of the first keycode
+    dynamic_keymap_set_keycode(0, 0, 0, 0x1200);
+    uint8_t buffer[] = {KC_X, 0x00, KC_Y};
+    dynamic_keymap_set_buffer(1, sizeof(buffer), buffer);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 0), 0x1200 | KC_X);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 1), KC_Y);
+    EXPECT_EQ(eeprom_keycode(0, 0, 0), dynamic_keymap_get_keycode(0, 0, 0));
+    EXPECT_EQ(eeprom_keycode(0, 0, 1), dynamic_keymap_get_keycode(0, 0, 1));
+
+    uint8_t read[sizeof(buffer)];
+    dynamic_keymap_get_buffer(1, sizeof(read), read);
+    EXPECT_EQ(memcmp(read, buffer, sizeof(read)), 0);
+}
+
+TEST_F(DynamicKeymapRamCache, ResetRestoresTheCacheAndEeprom) {
+    dynamic_keymap_set_keycode(0, 2, 4, KC_F13);
+    dynamic_keymap_reset();
+
+    for (uint8_t layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t column = 0; column < MATRIX_COLS; column++) {
+                uint16_t expected = keycode_at_keymap_location_raw(layer, row, column);
+                EXPECT_EQ(dynamic_keymap_get_keycode(layer, row, column), expected);
+                EXPECT_EQ(eeprom_keycode(layer, row, column), expected);
+            }
+        }
+    }
+}
@@ -0,0 +1,9 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+DYNAMIC_KEYMAP_ENABLE = yes
+
+# dynamic_keymap.c is built for Vial, vial_stubs.cpp stands in for vial.c
+OPT_DEFS += -DVIAL_ENABLE
+SRC += $(QUANTUM_DIR)/vial_bulk.c
+DEFERRED_EXEC_ENABLE = yes
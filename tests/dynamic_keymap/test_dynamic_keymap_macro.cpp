@@ -0,0 +1,197 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "deferred_exec.h"
+#include "dynamic_keymap.h"
+
+void set_time(uint32_t t);
+}
+
+using testing::_;
+using testing::InSequence;
+
+namespace {
+
+// A delay of `ms` as the player reads it, neither byte may be a null
+std::vector<uint8_t> macro_delay(uint16_t ms) {
+    return {SS_QMK_PREFIX, SS_DELAY_CODE, (uint8_t)(ms % 255 + 1), (uint8_t)(ms / 255 + 1)};
+}
+
+} // namespace
+
+class DynamicKeymapMacro : public TestFixture {
+   protected:
+    // deferred_exec_task() only runs once the timer passes its last run, so keep the
+    // clock going from where the previous test left it rather than restarting at 0
+    static uint32_t clock;
+
+    void SetUp() override {
+        set_time(clock);
+        dynamic_keymap_macro_reset();
+    }
+
+    void TearDown() override {
+        dynamic_keymap_macro_cancel();
+        TestFixture::TearDown();
+        clock = timer_read32();
+    }
+
+    // Stores the macros back to back, each followed by its null terminator
+    void set_macros(std::initializer_list<std::vector<uint8_t>> macros) {
+        std::vector<uint8_t> buffer;
+        for (auto &macro : macros) {
+            buffer.insert(buffer.end(), macro.begin(), macro.end());
+            buffer.push_back(0);
+        }
+        dynamic_keymap_macro_set_buffer(0, buffer.size(), buffer.data());
+    }
+
+    // The main loop runs the deferred executors alongside the keyboard task
+    void play_for(unsigned ms) {
+        for (unsigned i = 0; i < ms; i++) {
+            deferred_exec_task();
+            run_one_scan_loop();
+        }
+    }
+};
+
+uint32_t DynamicKeymapMacro::clock = 0;
+
+TEST_F(DynamicKeymapMacro, QueuedMacrosPlayInOrder) {
+    TestDriver driver;
+    InSequence s;
+
+    set_macros({{'a', 'b'}, {'c'}});
+
+    // The first action plays right away, the rest in the background
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    dynamic_keymap_macro_send(0);
+    dynamic_keymap_macro_send(1);
+    EXPECT_TRUE(dynamic_keymap_macro_is_playing());
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_C));
+    EXPECT_EMPTY_REPORT(driver);
+    play_for(10);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_FALSE(dynamic_keymap_macro_is_playing());
+}
+
+TEST_F(DynamicKeymapMacro, QueueOverflowDropsTheNewestMacros) {
+    TestDriver driver;
+    InSequence s;
+
+    set_macros({{'a'}, {'b'}, {'c'}, {'d'}, {'e'}, {'f'}});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_C));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_D));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_E));
+    EXPECT_EMPTY_REPORT(driver);
+    // One playing, DYNAMIC_KEYMAP_MACRO_QUEUE_SIZE queued, and the last one has no room
+    for (uint8_t id = 0; id < 6; id++) {
+        dynamic_keymap_macro_send(id);
+    }
+    play_for(50);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_FALSE(dynamic_keymap_macro_is_playing());
+}
+
+TEST_F(DynamicKeymapMacro, CancelReleasesHeldKeys) {
+    TestDriver           driver;
+    InSequence           s;
+    std::vector<uint8_t> held = {SS_QMK_PREFIX, SS_DOWN_CODE, KC_LEFT_SHIFT, SS_QMK_PREFIX, VIAL_MACRO_EXT_DOWN, KC_A, MOD_LCTL};
+    std::vector<uint8_t> wait = macro_delay(100);
+    held.insert(held.end(), wait.begin(), wait.end());
+    held.insert(held.end(), {SS_QMK_PREFIX, SS_UP_CODE, KC_LEFT_SHIFT});
+
+    set_macros({held, {'b'}});
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_LEFT_CTRL));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_LEFT_CTRL, KC_A));
+    dynamic_keymap_macro_send(0);
+    dynamic_keymap_macro_send(1);
+    play_for(10);
+    VERIFY_AND_CLEAR(driver);
+
+    // Both keys come up, and neither the rest of the macro nor the queued one plays
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL, KC_A));
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL));
+    EXPECT_EMPTY_REPORT(driver);
+    dynamic_keymap_macro_cancel();
+    EXPECT_FALSE(dynamic_keymap_macro_is_playing());
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    play_for(200);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicKeymapMacro, DelaysAreWaitedOutWithoutBlocking) {
+    TestDriver           driver;
+    InSequence           s;
+    std::vector<uint8_t> macro = {'a'};
+    std::vector<uint8_t> wait  = macro_delay(300);
+    macro.insert(macro.end(), wait.begin(), wait.end());
+    macro.push_back('b');
+
+    set_macros({macro});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    dynamic_keymap_macro_send(0);
+    VERIFY_AND_CLEAR(driver);
+
+    // The delay spans two bytes, and dynamic_keymap_macro_send() has already returned
+    EXPECT_NO_REPORT(driver);
+    play_for(295);
+    EXPECT_TRUE(dynamic_keymap_macro_is_playing());
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    play_for(10);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_FALSE(dynamic_keymap_macro_is_playing());
+}
+
+TEST_F(DynamicKeymapMacro, WritingTheBufferCancelsPlayback) {
+    TestDriver           driver;
+    InSequence           s;
+    std::vector<uint8_t> macro = {'a'};
+    std::vector<uint8_t> wait  = macro_delay(50);
+    macro.insert(macro.end(), wait.begin(), wait.end());
+    macro.push_back('b');
+
+    set_macros({macro});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    dynamic_keymap_macro_send(0);
+    play_for(10);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    set_macros({{'c'}});
+    EXPECT_FALSE(dynamic_keymap_macro_is_playing());
+    play_for(100);
+    VERIFY_AND_CLEAR(driver);
+}
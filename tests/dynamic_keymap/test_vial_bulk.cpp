@@ -0,0 +1,136 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "test_common.hpp"
+
+extern "C" {
+#include "dynamic_keymap.h"
+#include "vial_bulk.h"
+}
+
+namespace {
+
+// Payload of a bulk packet, after the command bytes
+const uint8_t PACKET_SIZE = 30;
+
+uint16_t no_filter(uint16_t keycode) {
+    return keycode;
+}
+
+uint16_t no_boot(uint16_t keycode) {
+    return keycode == QK_BOOT ? KC_NO : keycode;
+}
+
+std::vector<uint16_t> read_keymap(void) {
+    std::vector<uint16_t> keymap(dynamic_keymap_get_key_count());
+    dynamic_keymap_get_keycodes(0, keymap.size(), keymap.data());
+    return keymap;
+}
+
+void write_keymap(const std::vector<uint16_t> &keymap) {
+    dynamic_keymap_set_keycodes(0, keymap.size(), keymap.data());
+}
+
+} // namespace
+
+class VialBulk : public testing::Test {
+   protected:
+    void SetUp() override {
+        write_keymap(std::vector<uint16_t>(dynamic_keymap_get_key_count(), KC_NO));
+    }
+};
+
+TEST_F(VialBulk, RoundTrip) {
+    std::vector<uint16_t> keymap(dynamic_keymap_get_key_count(), KC_TRNS);
+    for (size_t i = 0; i < keymap.size(); i++) {
+        // Runs of fill keys between runs of literals, of varying lengths
+        if (i % 7 < 3 || i % 13 == 0) {
+            keymap[i] = KC_A + i % 26;
+        }
+    }
+    write_keymap(keymap);
+
+    std::vector<std::vector<uint8_t>> packets;
+    vial_bulk_cursor_t                cursor = {.pos = 0, .end = (uint16_t)keymap.size(), .fill = KC_TRNS};
+    while (cursor.pos < cursor.end) {
+        std::vector<uint8_t> packet(PACKET_SIZE, 0);
+        vial_bulk_encode(&cursor, packet.data(), packet.size());
+        packets.push_back(packet);
+    }
+
+    write_keymap(std::vector<uint16_t>(keymap.size(), KC_NO));
+    uint16_t index = 0;
+    for (auto &packet : packets) {
+        index += vial_bulk_decode(index, KC_TRNS, packet.data(), packet.size(), no_filter);
+    }
+    EXPECT_EQ(index, keymap.size());
+    EXPECT_EQ(read_keymap(), keymap);
+}
+
+TEST_F(VialBulk, FillRunsAreSkipped) {
+    write_keymap(std::vector<uint16_t>(dynamic_keymap_get_key_count(), KC_TRNS));
+
+    uint8_t            packet[PACKET_SIZE] = {0};
+    vial_bulk_cursor_t cursor              = {.pos = 0, .end = dynamic_keymap_get_key_count(), .fill = KC_TRNS};
+    vial_bulk_encode(&cursor, packet, sizeof(packet));
+
+    // The whole keymap fits one record with no literals
+    EXPECT_EQ(cursor.pos, cursor.end);
+    EXPECT_EQ(packet[0], dynamic_keymap_get_key_count());
+    EXPECT_EQ(packet[1], 0);
+    EXPECT_EQ(packet[2], 0);
+    EXPECT_EQ(packet[3], 0);
+}
+
+TEST_F(VialBulk, WriteStopsAtTheEndOfTheKeymap) {
+    uint16_t key_count = dynamic_keymap_get_key_count();
+    uint8_t  packet[]  = {1, 3, 0x00, KC_A, 0x00, KC_B, 0x00, KC_C, 0, 0};
+
+    EXPECT_EQ(vial_bulk_decode(key_count - 3, KC_X, packet, sizeof(packet), no_filter), 3);
+
+    std::vector<uint16_t> keymap = read_keymap();
+    EXPECT_EQ(keymap[key_count - 3], KC_X);
+    EXPECT_EQ(keymap[key_count - 2], KC_A);
+    EXPECT_EQ(keymap[key_count - 1], KC_B);
+    // Nothing wrapped around to the start
+    EXPECT_EQ(keymap[0], KC_NO);
+}
+
+TEST_F(VialBulk, WriteOutsideTheKeymapIsRejected) {
+    uint8_t packet[] = {0xFF, 2, 0x00, KC_A, 0x00, KC_B, 0, 0};
+
+    EXPECT_EQ(vial_bulk_decode(0xFFFF, KC_X, packet, sizeof(packet), no_filter), 0);
+    EXPECT_EQ(vial_bulk_decode(dynamic_keymap_get_key_count(), KC_X, packet, sizeof(packet), no_filter), 0);
+    EXPECT_EQ(read_keymap(), std::vector<uint16_t>(dynamic_keymap_get_key_count(), KC_NO));
+}
+
+TEST_F(VialBulk, LongFillRunIsWrittenInChunks) {
+    uint8_t packet[] = {40, 1, 0x00, KC_A, 0, 0};
+
+    EXPECT_EQ(vial_bulk_decode(2, KC_X, packet, sizeof(packet), no_filter), 41);
+
+    std::vector<uint16_t> keymap = read_keymap();
+    EXPECT_EQ(keymap[1], KC_NO);
+    for (int i = 2; i < 42; i++) {
+        EXPECT_EQ(keymap[i], KC_X);
+    }
+    EXPECT_EQ(keymap[42], KC_A);
+    EXPECT_EQ(keymap[43], KC_NO);
+}
+
+TEST_F(VialBulk, TruncatedRecordEndsTheWrite) {
+    // Claims three literals, but only carries one
+    uint8_t packet[] = {0, 1, 0x00, KC_A, 0, 3, 0x00, KC_B};
+
+    EXPECT_EQ(vial_bulk_decode(0, KC_X, packet, sizeof(packet), no_filter), 1);
+    EXPECT_EQ(read_keymap()[1], KC_NO);
+}
+
+TEST_F(VialBulk, KeycodesAreFiltered) {
+    uint8_t packet[] = {1, 1, QK_BOOT >> 8, QK_BOOT & 0xFF, 0, 0};
+
+    EXPECT_EQ(vial_bulk_decode(0, QK_BOOT, packet, sizeof(packet), no_boot), 2);
+    EXPECT_EQ(read_keymap()[0], KC_NO);
+    EXPECT_EQ(read_keymap()[1], KC_NO);
+}
@@ -0,0 +1,34 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// vial.c needs a generated keyboard definition, so these tests provide what the dynamic keymap uses from it
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "vial.h"
+
+int      vial_unlocked                 = 0;
+int      vial_unlock_in_progress       = 0;
+uint16_t g_vial_magic_keycode_override = 0;
+
+void vial_init(void) {}
+
+void vial_task(void) {}
+
+bool process_record_vial(uint16_t keycode, keyrecord_t *record) {
+    return true;
+}
+
+void vial_keycode_down(uint16_t keycode) {
+    register_code16(keycode);
+}
+
+void vial_keycode_up(uint16_t keycode) {
+    unregister_code16(keycode);
+}
+
+void vial_keycode_tap(uint16_t keycode) {
+    tap_code16(keycode);
+}
+}
@@ -0,0 +1,144 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "action_tapping.h"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+static uint32_t last_sleep = 0;
+
+extern "C" {
+// Record the requested sleep instead of advancing the mock timer, so the fixture keeps its 1ms per scan loop
+void idle_scheduler_sleep(uint32_t ms) {
+    last_sleep = ms;
+}
+
+static uint32_t deferred_exec_calls = 0;
+static uint32_t count_deferred_exec(uint32_t trigger_time, void *cb_arg) {
+    deferred_exec_calls++;
+    return 0;
+}
+}
+
+class IdleScheduler : public TestFixture {
+   protected:
+    void SetUp() override {
+        last_sleep          = 0;
+        deferred_exec_calls = 0;
+    }
+};
+
+TEST_F(IdleScheduler, NothingPendingSleepsForMaxSleep) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    EXPECT_EQ(idle_scheduler_next_deadline(), IDLE_SCHEDULER_NO_DEADLINE);
+    run_one_scan_loop();
+    EXPECT_EQ(last_sleep, IDLE_SCHEDULER_MAX_SLEEP);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(IdleScheduler, DeferredExecBoundsSleep) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    EXPECT_NE(defer_exec(4, count_deferred_exec, NULL), INVALID_DEFERRED_TOKEN);
+    EXPECT_EQ(idle_scheduler_next_deadline(), 4);
+
+    run_one_scan_loop();
+    EXPECT_EQ(last_sleep, 4);
+    idle_for(2);
+    deferred_exec_task();
+    EXPECT_EQ(deferred_exec_calls, 0);
+    EXPECT_EQ(idle_scheduler_next_deadline(), 1);
+
+    // Deferred executors are run from the main loop rather than keyboard_task()
+    run_one_scan_loop();
+    EXPECT_EQ(idle_scheduler_next_deadline(), 0);
+    deferred_exec_task();
+    EXPECT_EQ(deferred_exec_calls, 1);
+    EXPECT_EQ(idle_scheduler_next_deadline(), IDLE_SCHEDULER_NO_DEADLINE);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(IdleScheduler, NoSleepWhileMatrixChanges) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+
+    key.press();
+    EXPECT_REPORT(driver, (KC_A));
+    run_one_scan_loop();
+    EXPECT_EQ(last_sleep, 0);
+    VERIFY_AND_CLEAR(driver);
+
+    key.release();
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(IdleScheduler, TappingTermIsADeadline) {
+    TestDriver driver;
+    InSequence s;
+    auto       mod_tap_hold_key = KeymapKey(0, 7, 0, SFT_T(KC_P));
+
+    set_keymap({mod_tap_hold_key});
+
+    mod_tap_hold_key.press();
+    EXPECT_NO_REPORT(driver);
+    run_one_scan_loop();
+    EXPECT_EQ(idle_scheduler_next_deadline(), TAPPING_TERM - 1);
+    EXPECT_FALSE(idle_scheduler_tick_due());
+
+    idle_for(TAPPING_TERM - 2);
+    EXPECT_EQ(idle_scheduler_next_deadline(), 1);
+    run_one_scan_loop();
+    EXPECT_EQ(idle_scheduler_next_deadline(), 0);
+    EXPECT_TRUE(idle_scheduler_tick_due());
+    VERIFY_AND_CLEAR(driver);
+
+    // The tick event is still generated once the term has run out, and resolves the key as held
+    EXPECT_REPORT(driver, (KC_LSFT));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(idle_scheduler_next_deadline(), IDLE_SCHEDULER_NO_DEADLINE);
+
+    mod_tap_hold_key.release();
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(IdleScheduler, OneShotTimeoutIsADeadline) {
+    TestDriver driver;
+    InSequence s;
+    auto       osm_key = KeymapKey(0, 0, 0, OSM(MOD_LSFT), KC_LSFT);
+
+    set_keymap({osm_key});
+
+    EXPECT_NO_REPORT(driver);
+    osm_key.press();
+    run_one_scan_loop();
+    osm_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // The one-shot key is a tapping key as well, its tapping term runs out first
+    EXPECT_EQ(oneshot_next_deadline(), ONESHOT_TIMEOUT - 1);
+    EXPECT_EQ(idle_scheduler_next_deadline(), TAPPING_TERM - 1);
+    idle_for(TAPPING_TERM);
+    EXPECT_EQ(idle_scheduler_next_deadline(), ONESHOT_TIMEOUT - TAPPING_TERM - 1);
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(ONESHOT_TIMEOUT - TAPPING_TERM);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(idle_scheduler_next_deadline(), IDLE_SCHEDULER_NO_DEADLINE);
+    EXPECT_EQ(get_oneshot_mods(), 0);
+}
@@ -0,0 +1,118 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class ResolvedLayerCache : public TestFixture {};
+
+TEST_F(ResolvedLayerCache, TransparentKeysFallThrough) {
+    TestDriver driver;
+    KeymapKey  key_a      = KeymapKey(0, 0, 0, KC_A);
+    KeymapKey  key_b      = KeymapKey(0, 1, 0, KC_B);
+    KeymapKey  key_a_trns = KeymapKey(1, 0, 0, KC_TRNS);
+    KeymapKey  key_b_l1   = KeymapKey(1, 1, 0, KC_1);
+    KeymapKey  key_a_l2   = KeymapKey(2, 0, 0, KC_2);
+    KeymapKey  key_b_trns = KeymapKey(2, 1, 0, KC_TRNS);
+
+    set_keymap({key_a, key_b, key_a_trns, key_b_l1, key_a_l2, key_b_trns});
+
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+    EXPECT_EQ(layer_switch_get_layer(key_b.position), 0);
+
+    layer_on(1);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+    EXPECT_EQ(layer_switch_get_layer(key_b.position), 1);
+
+    layer_on(2);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 2);
+    EXPECT_EQ(layer_switch_get_layer(key_b.position), 1);
+    /* Cached lookups give the same answer */
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 2);
+    EXPECT_EQ(layer_switch_get_layer(key_b.position), 1);
+
+    layer_off(1);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 2);
+    EXPECT_EQ(layer_switch_get_layer(key_b.position), 0);
+
+    layer_clear();
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+    EXPECT_EQ(layer_switch_get_layer(key_b.position), 0);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ResolvedLayerCache, FollowsDefaultLayerAndDirectStateChanges) {
+    TestDriver driver;
+    KeymapKey  key_a    = KeymapKey(0, 0, 0, KC_A);
+    KeymapKey  key_a_l1 = KeymapKey(1, 0, 0, KC_1);
+
+    set_keymap({key_a, key_a_l1});
+
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+
+    default_layer_set(1 << 1);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 1);
+    default_layer_set(1 << 0);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+
+    /* State written without going through layer_state_set() */
+    layer_state = 1 << 1;
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 1);
+    layer_state = 0;
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ResolvedLayerCache, InvalidatedOnKeymapChange) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  key_a = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key_a, KeymapKey(1, 0, 0, KC_TRNS)});
+
+    layer_on(1);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+
+    /* Replace the transparent key on layer 1 */
+    KeymapKey key_a_l1 = KeymapKey(1, 0, 0, KC_1);
+    set_keymap({key_a, key_a_l1});
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 1);
+
+    EXPECT_REPORT(driver, (KC_1));
+    key_a_l1.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_a_l1.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ResolvedLayerCache, ReleaseUsesLayerOfPress) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  key_a    = KeymapKey(0, 0, 0, KC_A);
+    KeymapKey  key_a_l1 = KeymapKey(1, 0, 0, KC_1);
+
+    set_keymap({key_a, key_a_l1});
+
+    EXPECT_REPORT(driver, (KC_A));
+    key_a.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    layer_on(1);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,9 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// The same golden frames as the inline build, with the distances and angles taken from g_led_geometry
+#include "test_rgb_matrix_effects.cpp"
+
+#ifndef RGB_MATRIX_GEOMETRY_TABLE
+#    error "This build is meant to test the geometry table"
+#endif
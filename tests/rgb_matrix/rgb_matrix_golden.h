@@ -0,0 +1,53 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+/* Generated with RGB_MATRIX_GOLDEN_UPDATE, effects using libc rand() are not checked */
+static const std::map<std::string, uint32_t> rgb_matrix_golden = {
+    {"SOLID_COLOR", 0x1CD41BC5},
+    {"ALPHAS_MODS", 0xB3CD07C5},
+    {"GRADIENT_UP_DOWN", 0xCD6A67C5},
+    {"GRADIENT_LEFT_RIGHT", 0xA08411C5},
+    {"BREATHING", 0xA4880E6D},
+    {"BAND_SAT", 0x37A42A3D},
+    {"BAND_VAL", 0x6BD5C83D},
+    {"BAND_PINWHEEL_SAT", 0x880DC396},
+    {"BAND_PINWHEEL_VAL", 0x5364A04E},
+    {"BAND_SPIRAL_SAT", 0x921E3A9C},
+    {"BAND_SPIRAL_VAL", 0x7FD4A52F},
+    {"CYCLE_ALL", 0x5CD34265},
+    {"CYCLE_LEFT_RIGHT", 0x4192B055},
+    {"CYCLE_UP_DOWN", 0x67069EF9},
+    {"RAINBOW_MOVING_CHEVRON", 0xDB047A2B},
+    {"CYCLE_OUT_IN", 0xCB51EA13},
+    {"CYCLE_OUT_IN_DUAL", 0x897BE285},
+    {"CYCLE_PINWHEEL", 0x649A8221},
+    {"CYCLE_SPIRAL", 0xEBC7EFCD},
+    {"DUAL_BEACON", 0xCDCB391D},
+    {"RAINBOW_BEACON", 0x3BFC7C67},
+    {"RAINBOW_PINWHEELS", 0x315E5847},
+    {"FLOWER_BLOOMING", 0xECCA9FB3},
+    {"RAINDROPS", 0x1AC9B4AB},
+    {"JELLYBEAN_RAINDROPS", 0xFADBED19},
+    {"HUE_BREATHING", 0x24D30365},
+    {"HUE_PENDULUM", 0xAE5BAC35},
+    {"HUE_WAVE", 0x75FD5BCD},
+    {"PIXEL_RAIN", 0x0656368C},
+    {"PIXEL_FLOW", 0xD8DD3025},
+    {"PIXEL_FRACTAL", 0x846A3D4B},
+    {"TYPING_HEATMAP", 0x48868103},
+    {"SOLID_REACTIVE_SIMPLE", 0xCD1F328D},
+    {"SOLID_REACTIVE", 0xF737D3F3},
+    {"SOLID_REACTIVE_WIDE", 0x47EFD6E7},
+    {"SOLID_REACTIVE_MULTIWIDE", 0x084726CB},
+    {"SOLID_REACTIVE_CROSS", 0x4B89A011},
+    {"SOLID_REACTIVE_MULTICROSS", 0x8A5A41EB},
+    {"SOLID_REACTIVE_NEXUS", 0xF9C51957},
+    {"SOLID_REACTIVE_MULTINEXUS", 0xC73D5A3B},
+    {"SPLASH", 0x2996EF36},
+    {"MULTISPLASH", 0x24AF1406},
+    {"SOLID_SPLASH", 0x0265A97E},
+    {"SOLID_MULTISPLASH", 0xD3DF8B68},
+    {"RIVERFLOW", 0x9B3B80AF},
+};
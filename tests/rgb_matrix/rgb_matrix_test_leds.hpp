@@ -0,0 +1,61 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+/* A memory-backed RGB matrix driver and a one-LED-per-key layout, shared by the RGB matrix tests.
+   Include it from one source file per test, it defines g_led_config. The test defines
+   rgb_matrix_driver itself, from these functions or its own wrappers around them. */
+
+#include <cstring>
+
+extern "C" {
+#include "rgb_matrix.h"
+}
+
+namespace {
+
+RGB      led_buffer[RGB_MATRIX_LED_COUNT];
+RGB      flushed[RGB_MATRIX_LED_COUNT];
+uint32_t flush_count;
+uint32_t set_color_count;
+
+void memory_init(void) {
+    memset(led_buffer, 0, sizeof(led_buffer));
+    memset(flushed, 0, sizeof(flushed));
+}
+
+void memory_flush(void) {
+    memcpy(flushed, led_buffer, sizeof(flushed));
+    flush_count++;
+}
+
+void memory_set_color(int index, uint8_t r, uint8_t g, uint8_t b) {
+    set_color_count++;
+    led_buffer[index] = (RGB){r, g, b};
+}
+
+// Goes through the driver, so that a test's own set_color wrapper sees every LED
+void memory_set_color_all(uint8_t r, uint8_t g, uint8_t b) {
+    for (int i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        rgb_matrix_driver.set_color(i, r, g, b);
+    }
+}
+
+} // namespace
+
+extern "C" {
+// One LED per key, spread evenly over the 224x64 effect space, the outer columns are modifiers
+#define CO_ROW(r) \
+    { (r)*10 + 0, (r)*10 + 1, (r)*10 + 2, (r)*10 + 3, (r)*10 + 4, (r)*10 + 5, (r)*10 + 6, (r)*10 + 7, (r)*10 + 8, (r)*10 + 9 }
+#define POINT(c, r) \
+    { (c)*224 / 9, (r)*64 / 3 }
+#define POINT_ROW(r) POINT(0, r), POINT(1, r), POINT(2, r), POINT(3, r), POINT(4, r), POINT(5, r), POINT(6, r), POINT(7, r), POINT(8, r), POINT(9, r)
+#define FLAG_ROW 1, 4, 4, 4, 4, 4, 4, 4, 4, 1
+
+led_config_t g_led_config = {
+    {CO_ROW(0), CO_ROW(1), CO_ROW(2), CO_ROW(3)},
+    {POINT_ROW(0), POINT_ROW(1), POINT_ROW(2), POINT_ROW(3)},
+    {FLAG_ROW, FLAG_ROW, FLAG_ROW, FLAG_ROW},
+};
+}
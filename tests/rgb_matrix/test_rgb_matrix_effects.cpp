@@ -0,0 +1,174 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+#include "test_common.hpp"
+#include "rgb_matrix_test_leds.hpp"
+
+extern "C" {
+void     set_time(uint32_t t);
+void     advance_time(uint32_t ms);
+extern uint16_t rand16seed;
+}
+
+/* ---------- Memory-backed driver, counting conversions ---------- */
+
+static uint32_t conversion_count;
+
+extern "C" {
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = memory_init,
+    .set_color     = memory_set_color,
+    .set_color_all = memory_set_color_all,
+    .flush         = memory_flush,
+};
+
+RGB rgb_matrix_hsv_to_rgb(HSV hsv) {
+    conversion_count++;
+    return hsv_to_rgb(hsv);
+}
+}
+
+/* ---------- Effect harness ---------- */
+
+static const char* const effect_names[] = {
+    "NONE",
+#define RGB_MATRIX_EFFECT(name, ...) #name,
+#include "rgb_matrix_effects.inc"
+#undef RGB_MATRIX_EFFECT
+};
+static_assert(sizeof(effect_names) / sizeof(effect_names[0]) == RGB_MATRIX_EFFECT_MAX, "effect name table out of sync");
+
+/* FNV-1a hashes of the first RGB_MATRIX_GOLDEN_FRAMES frames of each effect, set RGB_MATRIX_GOLDEN_UPDATE to print new ones */
+#define RGB_MATRIX_GOLDEN_FRAMES 64
+#include "rgb_matrix_golden.h"
+
+/* These use rand(), whose sequence depends on the C library */
+static const std::set<std::string> libc_random_effects = {"DIGITAL_RAIN", "STARLIGHT", "STARLIGHT_DUAL_HUE", "STARLIGHT_DUAL_SAT"};
+
+struct EffectRun {
+    uint32_t hash        = 2166136261u;
+    uint32_t frames      = 0;
+    uint64_t elapsed_ns  = 0;
+    uint32_t set_colors  = 0;
+    uint32_t conversions = 0;
+};
+
+class RgbMatrixEffects : public TestFixture {
+   protected:
+    EffectRun run_effect(uint8_t mode, uint32_t frames) {
+        const char* frame_dir = std::getenv("RGB_MATRIX_FRAME_DIR");
+
+        // Every effect starts from the same state, whatever ran before it
+        set_time(0);
+        rgb_matrix_init();
+        rgb_matrix_mode_noeeprom(mode);
+        rgb_matrix_sethsv_noeeprom(HSV_RED);
+        rgb_matrix_set_speed_noeeprom(128);
+        memset(g_rgb_frame_buffer, 0, sizeof(g_rgb_frame_buffer));
+        rand16seed = 1337;
+        srand(1);
+
+        EffectRun run;
+        set_color_count  = 0;
+        conversion_count = 0;
+        for (uint32_t frame = 0; frame < frames; frame++) {
+            // A few key presses for the reactive effects
+            if (frame % 16 == 2 || frame % 16 == 5) {
+                uint8_t key = (frame * 7) % RGB_MATRIX_LED_COUNT;
+                process_rgb_matrix(key / MATRIX_COLS, key % MATRIX_COLS, true);
+                process_rgb_matrix(key / MATRIX_COLS, key % MATRIX_COLS, false);
+            }
+
+            // Drive the task a millisecond at a time until the next frame is flushed
+            uint32_t target = flush_count + 1;
+            for (int guard = 0; flush_count < target && guard < 1000; guard++) {
+                auto start = std::chrono::steady_clock::now();
+                rgb_matrix_task();
+                run.elapsed_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+                advance_time(1);
+            }
+            if (flush_count < target) {
+                ADD_FAILURE() << effect_names[mode] << " stopped flushing at frame " << frame;
+                break;
+            }
+
+            for (int i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+                for (uint8_t channel : {flushed[i].r, flushed[i].g, flushed[i].b}) {
+                    run.hash = (run.hash ^ channel) * 16777619u;
+                }
+            }
+            if (frame_dir) {
+                write_ppm(frame_dir, effect_names[mode], frame);
+            }
+            run.frames++;
+        }
+        run.set_colors  = set_color_count;
+        run.conversions = conversion_count;
+        return run;
+    }
+
+    /* Draws each LED as a block at its position, frames can be joined into an animation with e.g. ffmpeg -i NAME_%03d.ppm */
+    static void write_ppm(const char* dir, const char* name, uint32_t frame) {
+        const int width = 248, height = 88, margin = 12;
+        uint8_t   image[height][width][3] = {};
+        for (int i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+            int cx = g_led_config.point[i].x + margin;
+            int cy = g_led_config.point[i].y + margin;
+            for (int y = cy - 8; y <= cy + 8; y++) {
+                for (int x = cx - 10; x <= cx + 10; x++) {
+                    image[y][x][0] = flushed[i].r;
+                    image[y][x][1] = flushed[i].g;
+                    image[y][x][2] = flushed[i].b;
+                }
+            }
+        }
+
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%s_%03u.ppm", dir, name, (unsigned)frame);
+        FILE* file = fopen(path, "wb");
+        if (file) {
+            fprintf(file, "P6\n%d %d\n255\n", width, height);
+            fwrite(image, sizeof(image), 1, file);
+            fclose(file);
+        }
+    }
+};
+
+TEST_F(RgbMatrixEffects, GoldenFrames) {
+    bool update = std::getenv("RGB_MATRIX_GOLDEN_UPDATE") != nullptr;
+
+    for (uint8_t mode = RGB_MATRIX_NONE + 1; mode < RGB_MATRIX_EFFECT_MAX; mode++) {
+        EffectRun run = run_effect(mode, RGB_MATRIX_GOLDEN_FRAMES);
+        if (update) {
+            printf("    {\"%s\", 0x%08X},\n", effect_names[mode], (unsigned)run.hash);
+            continue;
+        }
+        if (libc_random_effects.count(effect_names[mode])) {
+            continue;
+        }
+        auto golden = rgb_matrix_golden.find(effect_names[mode]);
+        if (golden == rgb_matrix_golden.end()) {
+            ADD_FAILURE() << effect_names[mode] << " has no golden hash, run with RGB_MATRIX_GOLDEN_UPDATE set to generate it";
+            continue;
+        }
+        EXPECT_EQ(run.hash, golden->second) << effect_names[mode] << " renders differently, dump its frames with RGB_MATRIX_FRAME_DIR to compare";
+    }
+}
+
+TEST_F(RgbMatrixEffects, EffectCost) {
+    const uint32_t frames = 256;
+
+    for (uint8_t mode = RGB_MATRIX_NONE + 1; mode < RGB_MATRIX_EFFECT_MAX; mode++) {
+        EffectRun run = run_effect(mode, frames);
+        ASSERT_EQ(run.frames, frames);
+        printf("[ RGB      ] %-28s %7.0f ns/frame %6.1f set_color/frame %6.1f hsv_to_rgb/frame\n", effect_names[mode], double(run.elapsed_ns) / run.frames, double(run.set_colors) / run.frames, double(run.conversions) / run.frames);
+    }
+}
@@ -0,0 +1,117 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "rgb_matrix.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+class RgbMatrixHits : public TestFixture {
+   protected:
+    void SetUp() override {
+        set_time(0);
+        rgb_matrix_init();
+        rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_REACTIVE_SIMPLE);
+        rgb_matrix_task();
+    }
+
+    void hit(uint8_t led) {
+        process_rgb_matrix(led / MATRIX_COLS, led % MATRIX_COLS, true);
+        process_rgb_matrix(led / MATRIX_COLS, led % MATRIX_COLS, false);
+    }
+
+    // Runs the task every millisecond as the main loop would, hits are stamped with the time of the last run
+    void run_for(uint32_t ms) {
+        for (uint32_t i = 0; i < ms; i++) {
+            rgb_matrix_task();
+            advance_time(1);
+        }
+    }
+
+    // Long enough for a new frame to start, which is when g_last_hit_tracker picks up new hits
+    void run_frames(void) {
+        run_for(3 * RGB_MATRIX_LED_FLUSH_LIMIT);
+    }
+};
+
+TEST_F(RgbMatrixHits, KeepsMostRecentInOrder) {
+    for (int n = 0; n < LED_HITS_TO_REMEMBER + 3; n++) {
+        hit(n % RGB_MATRIX_LED_COUNT);
+        run_for(1);
+    }
+    run_frames();
+
+    ASSERT_EQ(g_last_hit_tracker.count, LED_HITS_TO_REMEMBER);
+    for (uint8_t j = 0; j < LED_HITS_TO_REMEMBER; j++) {
+        uint8_t slot = rgb_matrix_hit_slot(j);
+        uint8_t led  = (j + 3) % RGB_MATRIX_LED_COUNT;
+        EXPECT_EQ(g_last_hit_tracker.index[slot], led);
+        EXPECT_EQ(g_last_hit_tracker.x[slot], g_led_config.point[led].x);
+        if (j > 0) {
+            EXPECT_LE(rgb_matrix_hit_tick(slot), rgb_matrix_hit_tick(rgb_matrix_hit_slot(j - 1)));
+        }
+    }
+}
+
+TEST_F(RgbMatrixHits, TicksAgeWithTheFrame) {
+    run_frames();
+    hit(7);
+    run_frames();
+    ASSERT_EQ(g_last_hit_tracker.count, 1);
+    uint16_t first = rgb_matrix_hit_tick(rgb_matrix_hit_slot(0));
+
+    run_for(1000);
+    run_frames();
+    ASSERT_EQ(g_last_hit_tracker.count, 1);
+    EXPECT_GE(rgb_matrix_hit_tick(rgb_matrix_hit_slot(0)), first + 1000);
+}
+
+TEST_F(RgbMatrixHits, OldHitsExpire) {
+    hit(1);
+    run_frames();
+    run_for(30000);
+    hit(2);
+    run_frames();
+    ASSERT_EQ(g_last_hit_tracker.count, 2);
+
+    // Only the first hit is now more than UINT16_MAX ms old
+    run_for(40000);
+    run_frames();
+    ASSERT_EQ(g_last_hit_tracker.count, 1);
+    EXPECT_EQ(g_last_hit_tracker.index[rgb_matrix_hit_slot(0)], 2);
+
+    run_for(40000);
+    run_frames();
+    EXPECT_EQ(g_last_hit_tracker.count, 0);
+}
+
+TEST_F(RgbMatrixHits, HitsWaitForTheNextFrame) {
+    for (int n = 0; n < LED_HITS_TO_REMEMBER; n++) {
+        hit(n);
+    }
+    run_frames();
+
+    // Step to the end of the wait between frames, one task call starts the next frame and the
+    // one after takes the snapshot and renders the first slice
+    while (rgb_matrix_next_deadline() > 0) {
+        run_for(1);
+    }
+    run_for(2);
+
+    // The frame is still rendering, the hits it reads stay as they were
+    last_hit_t rendering = g_last_hit_tracker;
+    for (int n = 0; n < LED_HITS_PENDING; n++) {
+        hit(20 + n);
+    }
+    EXPECT_EQ(memcmp(&rendering, &g_last_hit_tracker, sizeof(last_hit_t)), 0);
+
+    run_frames();
+    ASSERT_EQ(g_last_hit_tracker.count, LED_HITS_TO_REMEMBER);
+    for (uint8_t j = 0; j < LED_HITS_PENDING; j++) {
+        EXPECT_EQ(g_last_hit_tracker.index[rgb_matrix_hit_slot(LED_HITS_TO_REMEMBER - LED_HITS_PENDING + j)], 20 + j);
+    }
+}
@@ -0,0 +1,8 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+RGB_MATRIX_ENABLE = yes
+RGB_MATRIX_DRIVER = custom
+
+# The memory-backed driver and LED layout shared by the RGB matrix tests
+VPATH += $(TOP_DIR)/tests/rgb_matrix
@@ -0,0 +1,152 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include "test_common.hpp"
+#include "rgb_matrix_test_leds.hpp"
+
+extern "C" {
+void     set_time(uint32_t t);
+void     advance_time(uint32_t ms);
+uint32_t timer_read32(void);
+void     rgb_matrix_update_pwm_buffers(void);
+}
+
+/* ---------- Memory-backed driver, sending a frame takes transfer_ms of simulated time ---------- */
+
+namespace {
+
+uint32_t transfer_ms;
+bool     transferring;
+uint32_t transfer_end;
+uint32_t async_flushes;
+uint32_t overlapping_flushes;
+uint32_t set_colors_while_transferring;
+
+void mock_set_color(int index, uint8_t r, uint8_t g, uint8_t b) {
+    if (transferring) {
+        set_colors_while_transferring++;
+    }
+    memory_set_color(index, r, g, b);
+}
+
+void mock_flush_async(void) {
+    if (transferring) {
+        overlapping_flushes++;
+    }
+    memcpy(flushed, led_buffer, sizeof(flushed));
+    transferring = true;
+    transfer_end = timer_read32() + transfer_ms;
+    async_flushes++;
+}
+
+// What the transfer complete interrupt would do
+void mock_poll(void) {
+    if (transferring && (int32_t)(timer_read32() - transfer_end) >= 0) {
+        transferring = false;
+        rgb_matrix_flush_complete();
+    }
+}
+
+void mock_flush(void) {
+    while (transferring) {
+        advance_time(1);
+        mock_poll();
+    }
+    memory_flush();
+}
+
+} // namespace
+
+extern "C" {
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = memory_init,
+    .set_color     = mock_set_color,
+    .set_color_all = memory_set_color_all,
+    .flush         = mock_flush,
+    .flush_async   = mock_flush_async,
+};
+}
+
+class RgbMatrixAsyncFlush : public TestFixture {
+   protected:
+    void SetUp() override {
+        set_time(0);
+        transfer_ms                   = 0;
+        transferring                  = false;
+        async_flushes                 = 0;
+        flush_count                   = 0;
+        overlapping_flushes           = 0;
+        set_colors_while_transferring = 0;
+        rgb_matrix_flush_complete();
+        rgb_matrix_init();
+        rgb_matrix_mode_noeeprom(RGB_MATRIX_CYCLE_ALL);
+        rgb_matrix_set_speed_noeeprom(UINT8_MAX);
+    }
+
+    void run_for(uint32_t ms) {
+        for (uint32_t i = 0; i < ms; i++) {
+            mock_poll();
+            rgb_matrix_task();
+            advance_time(1);
+        }
+    }
+};
+
+TEST_F(RgbMatrixAsyncFlush, RenderingOverlapsTransfer) {
+    // Longer than the frame period, flushing synchronously would add the render time on top of it
+    transfer_ms = RGB_MATRIX_LED_FLUSH_LIMIT + 4;
+    run_for(1000);
+
+    EXPECT_EQ(flush_count, 0);
+    EXPECT_EQ(overlapping_flushes, 0);
+    EXPECT_GT(set_colors_while_transferring, 0);
+    EXPECT_GE(async_flushes, 1000 / (transfer_ms + 1));
+}
+
+TEST_F(RgbMatrixAsyncFlush, SlowTransferHoldsBackTheNextFrame) {
+    transfer_ms = 3 * RGB_MATRIX_LED_FLUSH_LIMIT;
+    run_for(1000);
+
+    EXPECT_EQ(overlapping_flushes, 0);
+    EXPECT_LE(async_flushes, 1000 / transfer_ms + 1);
+    EXPECT_GE(async_flushes, 1000 / (transfer_ms + 1));
+}
+
+TEST_F(RgbMatrixAsyncFlush, FrontBufferKeepsTheFrameBeingSent) {
+    transfer_ms = 3 * RGB_MATRIX_LED_FLUSH_LIMIT;
+    run_for(RGB_MATRIX_LED_FLUSH_LIMIT * 2);
+    ASSERT_EQ(async_flushes, 1);
+    RGB sent[RGB_MATRIX_LED_COUNT];
+    memcpy(sent, flushed, sizeof(sent));
+
+    // The next frame is rendered into the back buffer meanwhile
+    bool back_changed = false;
+    while (async_flushes == 1) {
+        ASSERT_EQ(memcmp(sent, flushed, sizeof(sent)), 0);
+        back_changed |= memcmp(sent, led_buffer, sizeof(sent)) != 0;
+        run_for(1);
+    }
+    EXPECT_TRUE(back_changed);
+}
+
+TEST_F(RgbMatrixAsyncFlush, LostCompletionTimesOut) {
+    transfer_ms = UINT32_MAX / 2;
+    run_for(RGB_MATRIX_LED_FLUSH_LIMIT * 2);
+    ASSERT_EQ(async_flushes, 1);
+    EXPECT_TRUE(rgb_matrix_flush_in_progress());
+
+    run_for(RGB_MATRIX_FLUSH_ASYNC_TIMEOUT);
+    EXPECT_EQ(async_flushes, 2);
+}
+
+TEST_F(RgbMatrixAsyncFlush, SynchronousFlushWaitsForTransfer) {
+    transfer_ms = 3 * RGB_MATRIX_LED_FLUSH_LIMIT;
+    run_for(RGB_MATRIX_LED_FLUSH_LIMIT * 2);
+    ASSERT_TRUE(rgb_matrix_flush_in_progress());
+
+    rgb_matrix_update_pwm_buffers();
+    EXPECT_EQ(flush_count, 1);
+    EXPECT_FALSE(rgb_matrix_flush_in_progress());
+    EXPECT_EQ(memcmp(flushed, led_buffer, sizeof(flushed)), 0);
+}
@@ -0,0 +1,119 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+#include "rgb_matrix_test_leds.hpp"
+
+extern "C" {
+void     set_time(uint32_t t);
+void     advance_time(uint32_t ms);
+uint32_t timer_read32(void);
+}
+
+namespace {
+
+uint32_t led_cost_ms;
+uint32_t slices;
+uint8_t  largest_slice;
+
+} // namespace
+
+extern "C" {
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = memory_init,
+    .set_color     = memory_set_color,
+    .set_color_all = memory_set_color_all,
+    .flush         = memory_flush,
+};
+
+// Runs once per render slice, and stands in for an effect that takes led_cost_ms per LED
+bool rgb_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max) {
+    advance_time((led_max - led_min) * led_cost_ms);
+    slices++;
+    if (led_max - led_min > largest_slice) {
+        largest_slice = led_max - led_min;
+    }
+    return false;
+}
+}
+
+class RgbMatrixRenderBudget : public TestFixture {
+   protected:
+    void SetUp() override {
+        set_time(0);
+        led_cost_ms = 0;
+        rgb_matrix_init();
+        rgb_matrix_mode_noeeprom(RGB_MATRIX_CYCLE_ALL);
+    }
+
+    void run_for(uint32_t ms) {
+        uint32_t end = timer_read32() + ms;
+        while ((int32_t)(timer_read32() - end) < 0) {
+            rgb_matrix_task();
+            advance_time(1);
+        }
+    }
+
+    // Lets the smoothed per-LED cost settle, then counts slices afresh
+    void settle(void) {
+        run_for(2000);
+        slices        = 0;
+        largest_slice = 0;
+    }
+};
+
+TEST_F(RgbMatrixRenderBudget, CheapEffectRendersWholeFrames) {
+    settle();
+    run_for(1000);
+
+    rgb_matrix_render_stats_t stats;
+    rgb_matrix_get_render_stats(&stats);
+    EXPECT_EQ(stats.slice_leds, RGB_MATRIX_LED_COUNT);
+    EXPECT_EQ(stats.led_cost_us, 0);
+    EXPECT_EQ(largest_slice, RGB_MATRIX_LED_COUNT);
+    // A frame every flush period, apart from the task runs between them
+    EXPECT_GE(stats.fps, 1000 / (RGB_MATRIX_LED_FLUSH_LIMIT + 3));
+    EXPECT_EQ(stats.dropped_frames, 0);
+}
+
+TEST_F(RgbMatrixRenderBudget, SlicesShrinkToFitTheBudget) {
+    led_cost_ms = 1;
+    settle();
+    run_for(1000);
+
+    rgb_matrix_render_stats_t stats;
+    rgb_matrix_get_render_stats(&stats);
+    EXPECT_EQ(stats.led_cost_us, 1000);
+    EXPECT_EQ(stats.slice_leds, RGB_MATRIX_RENDER_BUDGET_US / 1000);
+    // No single task run spends much more than the budget rendering
+    EXPECT_LE(largest_slice, RGB_MATRIX_RENDER_BUDGET_US / 1000);
+    // A frame now takes several task runs, but frames still get finished
+    EXPECT_GE(slices, RGB_MATRIX_LED_COUNT / (RGB_MATRIX_RENDER_BUDGET_US / 1000) * stats.fps);
+    EXPECT_GT(stats.fps, 0);
+}
+
+TEST_F(RgbMatrixRenderBudget, SlowFramesAreCountedAsDropped) {
+    led_cost_ms = 1;
+    settle();
+
+    rgb_matrix_render_stats_t before, after;
+    rgb_matrix_get_render_stats(&before);
+    run_for(1000);
+    rgb_matrix_get_render_stats(&after);
+
+    // Rendering all LEDs takes RGB_MATRIX_LED_COUNT ms, longer than a flush period
+    EXPECT_GT(after.dropped_frames, before.dropped_frames);
+    EXPECT_LT(after.fps, 1000 / RGB_MATRIX_LED_FLUSH_LIMIT);
+    EXPECT_GE(after.fps, 1000 / (RGB_MATRIX_LED_COUNT * 2));
+}
+
+TEST_F(RgbMatrixRenderBudget, SlicesGrowBackWhenTheEffectGetsCheaper) {
+    led_cost_ms = 1;
+    settle();
+    led_cost_ms = 0;
+    settle();
+
+    rgb_matrix_render_stats_t stats;
+    rgb_matrix_get_render_stats(&stats);
+    EXPECT_EQ(stats.slice_leds, RGB_MATRIX_LED_COUNT);
+}
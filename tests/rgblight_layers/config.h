@@ -0,0 +1,11 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define RGBLED_NUM 16
+#define RGBLIGHT_LAYERS
+#define RGBLIGHT_LAYERS_COMPOSITOR
+#define RGBLIGHT_EFFECT_BREATHING
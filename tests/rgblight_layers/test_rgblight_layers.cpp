@@ -0,0 +1,134 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "rgblight.h"
+
+void advance_time(uint32_t ms);
+
+extern rgb_led_t ws2812_mock_leds[RGBLED_NUM];
+extern uint32_t  ws2812_mock_writes;
+
+const rgblight_segment_t PROGMEM red_layer[]   = RGBLIGHT_LAYER_SEGMENTS({0, 4, HSV_RED});
+const rgblight_segment_t PROGMEM green_layer[] = RGBLIGHT_LAYER_SEGMENTS({2, 4, HSV_GREEN}, {14, 8, HSV_GREEN});
+const rgblight_segment_t PROGMEM blue_layer[]  = RGBLIGHT_LAYER_SEGMENTS({10, 2, HSV_BLUE});
+
+const rgblight_segment_t *const PROGMEM test_layers[] = RGBLIGHT_LAYERS_LIST(red_layer, green_layer, blue_layer);
+}
+
+class RgblightLayers : public TestFixture {
+   protected:
+    void SetUp() override {
+        rgblight_layers = test_layers;
+        for (uint8_t i = 0; i < RGBLIGHT_MAX_LAYERS; i++) {
+            rgblight_set_layer_state(i, false);
+        }
+        rgblight_enable_noeeprom();
+        rgblight_mode_noeeprom(RGBLIGHT_MODE_STATIC_LIGHT);
+        rgblight_sethsv_noeeprom(0, 0, 100);
+        rgblight_task();
+    }
+
+    rgb_led_t color(uint8_t hue, uint8_t sat, uint8_t val) {
+        rgb_led_t led;
+        sethsv(hue, sat, val, &led);
+        return led;
+    }
+
+    // Colors expected on the strip, index by index
+    void expect_strip(const rgb_led_t (&expected)[RGBLED_NUM]) {
+        for (uint8_t i = 0; i < RGBLED_NUM; i++) {
+            EXPECT_EQ(ws2812_mock_leds[i].r, expected[i].r) << "LED " << (int)i;
+            EXPECT_EQ(ws2812_mock_leds[i].g, expected[i].g) << "LED " << (int)i;
+            EXPECT_EQ(ws2812_mock_leds[i].b, expected[i].b) << "LED " << (int)i;
+        }
+    }
+};
+
+TEST_F(RgblightLayers, LaterLayersTakePrecedence) {
+    rgblight_set_layer_state(0, true);
+    rgblight_set_layer_state(1, true);
+    rgblight_task();
+
+    rgb_led_t expected[RGBLED_NUM];
+    for (uint8_t i = 0; i < RGBLED_NUM; i++) {
+        expected[i] = color(0, 0, 100);
+    }
+    expected[0] = expected[1] = color(HSV_RED);
+    for (uint8_t i = 2; i < 6; i++) {
+        expected[i] = color(HSV_GREEN);
+    }
+    // The second green segment runs past the end of the strip
+    expected[14] = expected[15] = color(HSV_GREEN);
+    expect_strip(expected);
+}
+
+TEST_F(RgblightLayers, DisablingALayerUncoversTheBase) {
+    rgblight_set_layer_state(0, true);
+    rgblight_set_layer_state(1, true);
+    rgblight_set_layer_state(2, true);
+    rgblight_task();
+
+    // Red shows again where green was covering it, the base frame elsewhere
+    rgblight_set_layer_state(1, false);
+    rgblight_task();
+
+    rgb_led_t expected[RGBLED_NUM];
+    for (uint8_t i = 0; i < RGBLED_NUM; i++) {
+        expected[i] = color(0, 0, 100);
+    }
+    for (uint8_t i = 0; i < 4; i++) {
+        expected[i] = color(HSV_RED);
+    }
+    expected[10] = expected[11] = color(HSV_BLUE);
+    expect_strip(expected);
+
+    // led[] only ever holds the base frame
+    for (uint8_t i = 0; i < RGBLED_NUM; i++) {
+        EXPECT_EQ(led[i].r, expected[4].r) << "LED " << (int)i;
+    }
+}
+
+TEST_F(RgblightLayers, UnchangedFrameIsNotSent) {
+    rgblight_set_layer_state(2, true);
+    rgblight_task();
+    uint32_t writes = ws2812_mock_writes;
+
+    rgblight_set();
+    rgblight_set();
+    EXPECT_EQ(ws2812_mock_writes, writes);
+
+    // Toggled back before the next task run, the output is the same
+    rgblight_set_layer_state(2, false);
+    rgblight_set_layer_state(2, true);
+    rgblight_task();
+    EXPECT_EQ(ws2812_mock_writes, writes);
+
+    rgblight_set_layer_state(0, true);
+    rgblight_task();
+    EXPECT_EQ(ws2812_mock_writes, writes + 1);
+}
+
+TEST_F(RgblightLayers, BaseChangesStillShowAroundLayers) {
+    rgblight_set_layer_state(0, true);
+    rgblight_task();
+
+    rgblight_sethsv_noeeprom(HSV_BLUE);
+    rgblight_task();
+    EXPECT_EQ(ws2812_mock_leds[0].r, color(HSV_RED).r);
+    EXPECT_EQ(ws2812_mock_leds[8].b, color(HSV_BLUE).b);
+    EXPECT_EQ(ws2812_mock_leds[8].r, color(HSV_BLUE).r);
+}
+
+TEST_F(RgblightLayers, LayersFollowTheirOwnBrightnessWhileAnimating) {
+    rgblight_mode_noeeprom(RGBLIGHT_MODE_BREATHING);
+    rgblight_set_layer_state(2, true);
+    for (int i = 0; i < 200; i++) {
+        rgblight_task();
+        advance_time(5);
+        EXPECT_EQ(ws2812_mock_leds[10].b, color(HSV_BLUE).b);
+        EXPECT_EQ(ws2812_mock_leds[11].b, color(HSV_BLUE).b);
+    }
+}
@@ -0,0 +1,14 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "ws2812.h"
+
+// Stands in for the strip, keeping what was last sent to it
+rgb_led_t ws2812_mock_leds[RGBLED_NUM];
+uint32_t  ws2812_mock_writes;
+
+void ws2812_setleds(rgb_led_t *ledarray, uint16_t number_of_leds) {
+    memcpy(ws2812_mock_leds, ledarray, number_of_leds * sizeof(rgb_led_t));
+    ws2812_mock_writes++;
+}
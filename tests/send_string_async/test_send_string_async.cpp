@@ -0,0 +1,163 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+static int callback_calls = 0;
+
+extern "C" {
+static void count_callback(void *cb_arg) {
+    callback_calls += *(int *)cb_arg;
+}
+}
+
+class SendStringAsync : public TestFixture {
+   protected:
+    void SetUp() override {
+        callback_calls = 0;
+    }
+
+    void TearDown() override {
+        send_string_async_flush();
+    }
+};
+
+TEST_F(SendStringAsync, TypesOneKeystrokePerScan) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_NO_REPORT(driver);
+    send_string_async("ab");
+    EXPECT_TRUE(send_string_async_busy());
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_FALSE(send_string_async_busy());
+    EXPECT_EQ(send_string_async_next_deadline(), UINT32_MAX);
+}
+
+TEST_F(SendStringAsync, KeysAreProcessedWhileTyping) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  key_x = KeymapKey(0, 0, 0, KC_X);
+
+    set_keymap({key_x});
+
+    send_string_async_with_delay("ab", 10);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_X));
+    key_x.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(8);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_X, KC_B));
+    EXPECT_REPORT(driver, (KC_X));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_x.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, DelayCodesAreWaitedOut) {
+    TestDriver driver;
+    InSequence s;
+
+    send_string_async("a" SS_DELAY(20) "b");
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(send_string_async_next_deadline(), 19);
+    EXPECT_NO_REPORT(driver);
+    idle_for(19);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, CallbacksRunOnceQueuedTextIsTyped) {
+    TestDriver driver;
+    int        one = 1;
+
+    EXPECT_ANY_REPORT(driver).Times(4);
+    send_string_async("a");
+    send_string_async_callback(count_callback, &one);
+    send_string_async("b");
+    send_string_async_callback(count_callback, &one);
+
+    run_one_scan_loop();
+    EXPECT_EQ(callback_calls, 1);
+    run_one_scan_loop();
+    EXPECT_EQ(callback_calls, 2);
+    EXPECT_FALSE(send_string_async_busy());
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, FullQueueTypesOldestKeystrokes) {
+    TestDriver driver;
+    InSequence s;
+
+    /* Ten characters in an eight entry queue, the first two go out straight away */
+    EXPECT_REPORT(driver, (KC_1));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_2));
+    EXPECT_EMPTY_REPORT(driver);
+    send_string_async("1234567890");
+    VERIFY_AND_CLEAR(driver);
+
+    for (uint16_t keycode : {KC_3, KC_4, KC_5, KC_6, KC_7, KC_8, KC_9, KC_0}) {
+        EXPECT_REPORT(driver, (keycode));
+        EXPECT_EMPTY_REPORT(driver);
+        run_one_scan_loop();
+        VERIFY_AND_CLEAR(driver);
+    }
+    EXPECT_FALSE(send_string_async_busy());
+}
+
+TEST_F(SendStringAsync, BlockingSendStringDoesNotOvertakeQueue) {
+    TestDriver driver;
+    InSequence s;
+
+    send_string_async("a");
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    send_string("b");
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_FALSE(send_string_async_busy());
+}
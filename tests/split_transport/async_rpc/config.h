@@ -0,0 +1,14 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define SPLIT_LAYER_STATE_ENABLE
+#define SPLIT_MODS_ENABLE
+#define SPLIT_TRANSACTION_IDS_USER USER_ECHO
+#define SPLIT_TRANSACTIONS_ASYNC_RPC
+
+#define FORCED_SYNC_THROTTLE_MS 100
+#define SPLIT_CONNECTION_CHECK_TIMEOUT 500
@@ -0,0 +1,8 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+SPLIT_KEYBOARD = yes
+SERIAL_DRIVER = loopback
+
+# The split fixture
+VPATH += $(TOP_DIR)/tests/split_transport
@@ -0,0 +1,142 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "split_transport_fixture.hpp"
+
+namespace {
+
+struct completion {
+    bool                 success;
+    std::vector<uint8_t> response;
+    uintptr_t            cb_arg;
+};
+
+std::vector<completion> completions;
+
+void record_completion(int8_t transaction_id, bool success, uint8_t target2initiator_buffer_size, const void *target2initiator_buffer, void *cb_arg) {
+    const uint8_t *response = (const uint8_t *)target2initiator_buffer;
+    completions.push_back({success, std::vector<uint8_t>(response, response + target2initiator_buffer_size), (uintptr_t)cb_arg});
+}
+
+} // namespace
+
+class SplitTransportAsyncRpc : public SplitTransport {
+   protected:
+    bool corrupt_responses = false;
+
+    void SetUp() override {
+        SplitTransport::SetUp();
+        completions.clear();
+    }
+
+    // Spoils the response on its way to the master, as a damaged transfer would, but not the slave's own copy
+    bool scan(void) override {
+        serial_loopback_slave_scan(slave_keyboard, slave_keyboard + ROWS_PER_HAND);
+        uint8_t checksum = serial_loopback_slave_shmem->rpc_async_response.checksum;
+        if (corrupt_responses) {
+            serial_loopback_slave_shmem->rpc_async_response.checksum ^= 0xFF;
+        }
+        bool okay = transport_master_if_connected(master_keyboard, master_keyboard + ROWS_PER_HAND);
+        if (corrupt_responses) {
+            serial_loopback_slave_shmem->rpc_async_response.checksum = checksum;
+        }
+        advance_time(1);
+        return okay;
+    }
+
+    void TearDown() override {
+        // Nothing left in the queue for the next test
+        link(NULL);
+        run_for(SPLIT_RPC_ASYNC_ATTEMPTS * SPLIT_RPC_ASYNC_RESEND_MS);
+        SplitTransport::TearDown();
+    }
+
+    bool echo_async(std::vector<uint8_t> request, uintptr_t cb_arg) {
+        return transaction_rpc_exec_async(USER_ECHO, request.size(), request.data(), request.size(), record_completion, (void *)cb_arg);
+    }
+
+    // Scans until `count` calls have completed, giving up after `limit`
+    uint32_t scans_until_completed(size_t count, uint32_t limit) {
+        uint32_t scans = 0;
+        while (scans < limit && completions.size() < count) {
+            scan();
+            scans++;
+        }
+        EXPECT_EQ(completions.size(), count);
+        return scans;
+    }
+};
+
+TEST_F(SplitTransportAsyncRpc, EchoCompletesOnALaterScan) {
+    ASSERT_TRUE(echo_async({1, 2, 3, 4}, 7));
+    // Queued, the master sends it when it next syncs
+    EXPECT_EQ(echo_calls, 0);
+    EXPECT_TRUE(completions.empty());
+
+    // Sent on one scan, run by the slave on the next, and the response fetched after that
+    EXPECT_LE(scans_until_completed(1, 10), 4);
+    EXPECT_EQ(echo_calls, 1);
+    EXPECT_TRUE(completions[0].success);
+    EXPECT_EQ(completions[0].response, std::vector<uint8_t>({2, 3, 4, 5}));
+    EXPECT_EQ(completions[0].cb_arg, 7);
+}
+
+TEST_F(SplitTransportAsyncRpc, QueuedCallsCompleteInOrder) {
+    for (uint8_t i = 0; i < SPLIT_RPC_ASYNC_QUEUE_SIZE; i++) {
+        ASSERT_TRUE(echo_async({i}, i));
+    }
+    // The queue is full until the first call completes
+    EXPECT_FALSE(echo_async({0}, 0));
+
+    scans_until_completed(SPLIT_RPC_ASYNC_QUEUE_SIZE, 10 * SPLIT_RPC_ASYNC_QUEUE_SIZE);
+    EXPECT_EQ(echo_calls, SPLIT_RPC_ASYNC_QUEUE_SIZE);
+    for (uint8_t i = 0; i < completions.size(); i++) {
+        EXPECT_TRUE(completions[i].success);
+        EXPECT_EQ(completions[i].cb_arg, i);
+        EXPECT_EQ(completions[i].response, std::vector<uint8_t>({(uint8_t)(i + 1)}));
+    }
+}
+
+TEST_F(SplitTransportAsyncRpc, LostTransfersAreResent) {
+    serial_loopback_config_t config = {.timeout_us = 1000, .drop_ppm = 10000, .seed = 11};
+    link(&config);
+
+    const uint8_t calls = 20;
+    for (uint8_t i = 0; i < calls; i++) {
+        ASSERT_TRUE(echo_async({i, i}, i));
+        scans_until_completed(i + 1, SPLIT_RPC_ASYNC_ATTEMPTS * SPLIT_RPC_ASYNC_RESEND_MS * 2);
+    }
+
+    serial_loopback_stats_t requests;
+    serial_loopback_get_stats(PUT_RPC_ASYNC_REQUEST, &requests);
+    EXPECT_GT(requests.failures, 0);
+    // A resend of a request the slave already ran is not run again
+    EXPECT_EQ(echo_calls, calls);
+    for (uint8_t i = 0; i < calls; i++) {
+        EXPECT_TRUE(completions[i].success);
+        EXPECT_EQ(completions[i].response, std::vector<uint8_t>({(uint8_t)(i + 1), (uint8_t)(i + 1)}));
+    }
+}
+
+TEST_F(SplitTransportAsyncRpc, UnansweredCallsTimeOut) {
+    ASSERT_TRUE(echo_async({1}, 1));
+    corrupt_responses = true;
+
+    uint32_t scans = scans_until_completed(1, 2 * SPLIT_RPC_ASYNC_ATTEMPTS * SPLIT_RPC_ASYNC_RESEND_MS);
+    EXPECT_GE(scans, SPLIT_RPC_ASYNC_ATTEMPTS * SPLIT_RPC_ASYNC_RESEND_MS);
+    EXPECT_FALSE(completions[0].success);
+    EXPECT_TRUE(completions[0].response.empty());
+
+    serial_loopback_stats_t requests;
+    serial_loopback_get_stats(PUT_RPC_ASYNC_REQUEST, &requests);
+    EXPECT_EQ(requests.transfers, SPLIT_RPC_ASYNC_ATTEMPTS);
+    // The slave ran the call once, the resends only asked for its response again
+    EXPECT_EQ(echo_calls, 1);
+
+    // The queue moves on once responses get through again
+    corrupt_responses = false;
+    ASSERT_TRUE(echo_async({2}, 2));
+    scans_until_completed(2, 10);
+    EXPECT_TRUE(completions[1].success);
+}
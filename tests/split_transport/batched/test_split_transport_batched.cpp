@@ -0,0 +1,122 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "split_transport_fixture.hpp"
+
+extern "C" {
+#include "crc.h"
+}
+
+class SplitTransportBatched : public SplitTransport {
+   protected:
+    void TearDown() override {
+        layer_clear();
+        clear_mods();
+        SplitTransport::TearDown();
+    }
+
+    uint32_t transfers(int8_t id) {
+        serial_loopback_stats_t stats;
+        serial_loopback_get_stats(id, &stats);
+        return stats.transfers;
+    }
+};
+
+// A master that restarted while the slave kept running: the slave has already applied
+// frame 1, the number a freshly started master would give its first frame
+class SplitTransportBatchedRestart : public SplitTransportBatched {
+   protected:
+    void SetUp() override {
+        set_time(0);
+        serial_loopback_reset(NULL);
+
+        split_batch_frame_t *frame = &serial_loopback_slave_shmem->batch_frame;
+        frame->seq                 = 1;
+        frame->length              = 0;
+        frame->checksum            = crc8(&frame->seq, 2);
+        serial_loopback_slave_scan(slave_keyboard, slave_keyboard + ROWS_PER_HAND);
+    }
+};
+
+// Runs first, while the master has yet to send a frame
+TEST_F(SplitTransportBatchedRestart, FramesFromARestartedMasterAreApplied) {
+    layer_on(2);
+    run_for(FORCED_SYNC_THROTTLE_MS / 2);
+    EXPECT_EQ(serial_loopback_slave_layer_state, (layer_state_t)1 << 2);
+}
+
+TEST_F(SplitTransportBatched, StateChangesShareOneFrame) {
+    // Let the frame still in flight from the forced syncs be acknowledged
+    run_for(SPLIT_BATCH_RESEND_MS);
+
+    uint32_t frames = transfers(PUT_BATCH_FRAME);
+    layer_on(3);
+    set_mods(MOD_BIT(KC_LEFT_SHIFT));
+    // Queued on the first scan, sent on the second and applied by the slave on the third
+    run_for(3);
+
+    EXPECT_EQ(transfers(PUT_BATCH_FRAME) - frames, 1);
+    EXPECT_EQ(transfers(PUT_LAYER_STATE), 0);
+    EXPECT_EQ(transfers(PUT_MODS), 0);
+    EXPECT_EQ(serial_loopback_slave_layer_state, (layer_state_t)1 << 3);
+    EXPECT_EQ(serial_loopback_slave_mods.real_mods, MOD_BIT(KC_LEFT_SHIFT));
+}
+
+TEST_F(SplitTransportBatched, FramesOnlySendTheirLength) {
+    run_for(SPLIT_BATCH_RESEND_MS);
+
+    serial_loopback_stats_t before, after;
+    serial_loopback_get_stats(PUT_BATCH_FRAME, &before);
+    layer_on(3);
+    run_for(3);
+    serial_loopback_get_stats(PUT_BATCH_FRAME, &after);
+
+    ASSERT_EQ(after.transfers - before.transfers, 1);
+    const split_batch_frame_t *frame = &serial_loopback_slave_shmem->batch_frame;
+    EXPECT_EQ(after.bytes_out - before.bytes_out, offsetof(split_batch_frame_t, data) + frame->length);
+    EXPECT_LT(after.bytes_out - before.bytes_out, sizeof(split_batch_frame_t));
+    EXPECT_EQ(serial_loopback_slave_layer_state, (layer_state_t)1 << 3);
+}
+
+TEST_F(SplitTransportBatched, SlaveMatrixComesBackInTheReply) {
+    EXPECT_LE(key_latency_ms(1, 3, 10), 1);
+    EXPECT_EQ(transfers(GET_SLAVE_MATRIX_CHECKSUM), 0);
+    EXPECT_EQ(transfers(GET_SLAVE_MATRIX_DATA), 0);
+    // Both frames and polls bring the reply back
+    EXPECT_GT(transfers(PUT_BATCH_FRAME) + transfers(GET_BATCH_REPLY), 0);
+}
+
+TEST_F(SplitTransportBatched, SyncTimerIsSentAsItIsRead) {
+    // Slow enough that a queued value would be several milliseconds old when it arrived
+    serial_loopback_config_t config = {.bytes_per_second = 960};
+    link(&config);
+    layer_on(1);
+
+    uint32_t checked = 0;
+    for (uint32_t i = 0; i < 3 * FORCED_SYNC_THROTTLE_MS; i++) {
+        uint32_t sent  = transfers(PUT_SYNC_TIMER);
+        uint32_t start = timer_read32();
+        scan();
+        if (transfers(PUT_SYNC_TIMER) > sent) {
+            // Read during this scan, rather than whenever it was queued
+            uint32_t sync_timer = serial_loopback_slave_shmem->sync_timer - 2;
+            EXPECT_GE(sync_timer, start);
+            EXPECT_LE(sync_timer, timer_read32());
+            checked++;
+        }
+    }
+    EXPECT_GE(checked, 2);
+}
+
+TEST_F(SplitTransportBatched, LostFramesAreResent) {
+    serial_loopback_config_t config = {.timeout_us = 1000, .drop_ppm = 100000, .seed = 7};
+    link(&config);
+
+    layer_on(4);
+    run_for(FORCED_SYNC_THROTTLE_MS);
+
+    serial_loopback_stats_t frames;
+    serial_loopback_get_stats(PUT_BATCH_FRAME, &frames);
+    EXPECT_GT(frames.failures, 0);
+    EXPECT_EQ(serial_loopback_slave_layer_state, (layer_state_t)1 << 4);
+}
@@ -0,0 +1,69 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "split_transport_fixture.hpp"
+
+extern "C" {
+#include "split_telemetry.h"
+}
+
+// Batched, scheduled, async RPC and telemetry all at once
+class SplitTransportCombined : public SplitTransport {
+   protected:
+    void SetUp() override {
+        SplitTransport::SetUp();
+        split_telemetry_reset();
+    }
+};
+
+namespace {
+
+bool    async_success;
+uint8_t async_response;
+
+void record_async(int8_t transaction_id, bool success, uint8_t target2initiator_buffer_size, const void *target2initiator_buffer, void *cb_arg) {
+    async_success  = success;
+    async_response = success ? *(const uint8_t *)target2initiator_buffer : 0;
+}
+
+} // namespace
+
+TEST_F(SplitTransportCombined, EverySyncTransactionIsMeasured) {
+    serial_loopback_config_t config = {.bytes_per_second = 1000, .latency_us = 50};
+    link(&config);
+    split_telemetry_reset();
+
+    exercise_every_transaction();
+    expect_every_transaction_measured(config);
+
+    // Telemetry saw the same transfers as the link
+    for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; id++) {
+        serial_loopback_stats_t link_stats;
+        split_telemetry_stats_t stats;
+        serial_loopback_get_stats(id, &link_stats);
+        split_telemetry_get_stats(id, &stats);
+        EXPECT_EQ(stats.transfers + stats.failures, link_stats.transfers) << "transaction " << +id;
+    }
+}
+
+TEST_F(SplitTransportCombined, KeysAndStateStillArrive) {
+    EXPECT_LE(key_latency_ms(1, 3, 10), 1);
+
+    layer_on(2);
+    set_mods(MOD_BIT(KC_RIGHT_ALT));
+    run_for(SPLIT_BATCH_RESEND_MS);
+    EXPECT_EQ(serial_loopback_slave_layer_state, (layer_state_t)1 << 2);
+    EXPECT_EQ(serial_loopback_slave_mods.real_mods, MOD_BIT(KC_RIGHT_ALT));
+    layer_clear();
+    clear_mods();
+}
+
+TEST_F(SplitTransportCombined, AsyncRpcCompletes) {
+    uint8_t request = 41;
+    async_success   = false;
+    ASSERT_TRUE(transaction_rpc_exec_async(USER_ECHO, sizeof(request), &request, sizeof(request), record_async, NULL));
+    run_for(10);
+    EXPECT_TRUE(async_success);
+    EXPECT_EQ(async_response, 42);
+    EXPECT_EQ(echo_calls, 1);
+}
@@ -0,0 +1,16 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define SPLIT_TRANSACTION_IDS_USER USER_ECHO
+
+#define FORCED_SYNC_THROTTLE_MS 100
+#define SPLIT_CONNECTION_CHECK_TIMEOUT 500
+
+#define RGB_MATRIX_LED_COUNT (MATRIX_ROWS * MATRIX_COLS)
+#define RGB_MATRIX_SPLIT \
+    { 20, 20 }
+#define SPLIT_RGB_MATRIX_COLORS_ENABLE
@@ -0,0 +1,11 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+SPLIT_KEYBOARD = yes
+SERIAL_DRIVER = loopback
+RGB_MATRIX_ENABLE = yes
+RGB_MATRIX_DRIVER = custom
+
+# The split fixture, and the memory-backed driver and LED layout shared by the RGB matrix tests
+VPATH += $(TOP_DIR)/tests/split_transport
+VPATH += $(TOP_DIR)/tests/rgb_matrix
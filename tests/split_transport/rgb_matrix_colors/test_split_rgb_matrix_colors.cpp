@@ -0,0 +1,116 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "rgb_matrix_test_leds.hpp"
+#include "split_transport_fixture.hpp"
+
+#define REMOTE_FIRST 20
+
+namespace {
+
+// Painted onto every slave LED by the master's indicators, when set
+bool    paint_remote;
+uint8_t shade;
+// Blanks the whole matrix from the master's indicators, when set
+bool clear_all;
+
+} // namespace
+
+extern "C" {
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = memory_init,
+    .set_color     = memory_set_color,
+    .set_color_all = memory_set_color_all,
+    .flush         = memory_flush,
+};
+
+// The advanced indicators only cover this half's LEDs, these run once over the whole frame
+bool rgb_matrix_indicators_user(void) {
+    if (clear_all) {
+        rgb_matrix_set_color_all(0, 0, 0);
+    }
+    if (paint_remote) {
+        for (uint8_t i = REMOTE_FIRST; i < RGB_MATRIX_LED_COUNT; i++) {
+            rgb_matrix_set_color(i, shade, i, 0);
+        }
+    }
+    return false;
+}
+}
+
+class SplitRgbMatrixColors : public SplitTransport {
+   protected:
+    void SetUp() override {
+        paint_remote = false;
+        clear_all    = false;
+        rgb_matrix_enable_noeeprom();
+        rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_COLOR);
+        SplitTransport::SetUp();
+    }
+
+    // The master renders alongside its transport, as keyboard_task() would
+    bool scan(void) override {
+        rgb_matrix_task();
+        return SplitTransport::scan();
+    }
+};
+
+TEST_F(SplitRgbMatrixColors, EveryRemoteLedChangingEachFrameGetsSent) {
+    paint_remote = true;
+    for (uint32_t i = 0; i < 2000; i++) {
+        shade++;
+        scan();
+    }
+
+    // Twice as many LEDs as fit one sync change every frame, yet none of them starves
+    uint32_t least = UINT32_MAX, most = 0;
+    for (uint8_t i = REMOTE_FIRST; i < RGB_MATRIX_LED_COUNT; i++) {
+        rgb_matrix_split_color_t color;
+        uint32_t                 updates = serial_loopback_slave_rgb_matrix_color(i, &color);
+        least                            = updates < least ? updates : least;
+        most                             = updates > most ? updates : most;
+    }
+    EXPECT_GT(least, 0);
+    EXPECT_GE(least, most / 2);
+}
+
+TEST_F(SplitRgbMatrixColors, SlaveCatchesUpOnceColorsSettle) {
+    paint_remote = true;
+    for (uint32_t i = 0; i < 500; i++) {
+        shade++;
+        scan();
+    }
+    run_for(FORCED_SYNC_THROTTLE_MS);
+
+    for (uint8_t i = REMOTE_FIRST; i < RGB_MATRIX_LED_COUNT; i++) {
+        rgb_matrix_split_color_t color;
+        serial_loopback_slave_rgb_matrix_color(i, &color);
+        EXPECT_TRUE(color.valid) << "LED " << (int)i;
+        EXPECT_EQ(color.r, shade) << "LED " << (int)i;
+        EXPECT_EQ(color.g, i) << "LED " << (int)i;
+    }
+
+    // LEDs the indicators stop painting are handed back to the slave's own effect
+    paint_remote = false;
+    run_for(FORCED_SYNC_THROTTLE_MS);
+    for (uint8_t i = REMOTE_FIRST; i < RGB_MATRIX_LED_COUNT; i++) {
+        rgb_matrix_split_color_t color;
+        serial_loopback_slave_rgb_matrix_color(i, &color);
+        EXPECT_FALSE(color.valid) << "LED " << (int)i;
+    }
+}
+
+TEST_F(SplitRgbMatrixColors, ClearingTheMatrixLeavesTheSlaveItsOwnColors) {
+    clear_all = true;
+    run_for(FORCED_SYNC_THROTTLE_MS);
+
+    // A fill covers the other half's LEDs too, but only colors set one by one are sent over
+    for (uint8_t i = REMOTE_FIRST; i < RGB_MATRIX_LED_COUNT; i++) {
+        rgb_matrix_split_color_t color;
+        serial_loopback_slave_rgb_matrix_color(i, &color);
+        EXPECT_FALSE(color.valid) << "LED " << (int)i;
+    }
+    for (uint8_t i = 0; i < REMOTE_FIRST; i++) {
+        EXPECT_EQ(led_buffer[i].r, 0) << "LED " << (int)i;
+    }
+}
@@ -0,0 +1,66 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "split_transport_fixture.hpp"
+
+class SplitTransportScheduled : public SplitTransport {
+   protected:
+    void TearDown() override {
+        layer_clear();
+        SplitTransport::TearDown();
+    }
+
+    // Far more than a scan's budget
+    void rpc(void) {
+        uint8_t request[RPC_M2S_BUFFER_SIZE] = {0};
+        uint8_t response[RPC_S2M_BUFFER_SIZE];
+        EXPECT_TRUE(transaction_rpc_exec(USER_ECHO, sizeof(request), request, sizeof(response), response));
+    }
+
+    // Scans until the slave has the layer, giving up after `limit`
+    uint32_t layer_latency_scans(uint8_t layer, uint32_t limit, bool rpc_every_scan) {
+        uint32_t scans = 0;
+        while (scans < limit && serial_loopback_slave_layer_state != (layer_state_t)1 << layer) {
+            scan();
+            if (rpc_every_scan) {
+                rpc();
+            }
+            scans++;
+        }
+        EXPECT_EQ(serial_loopback_slave_layer_state, (layer_state_t)1 << layer);
+        return scans;
+    }
+};
+
+TEST_F(SplitTransportScheduled, IdleScansSendStateRightAway) {
+    layer_on(1);
+    // Sent on the first scan, and applied by the slave on the second
+    EXPECT_EQ(layer_latency_scans(1, 10, false), 2);
+}
+
+TEST_F(SplitTransportScheduled, RpcTrafficDefersStateButNotInput) {
+    rpc();
+
+    layer_on(2);
+    EXPECT_LE(key_latency_ms(1, 3, 10), 1);
+    EXPECT_NE(serial_loopback_slave_layer_state, (layer_state_t)1 << 2);
+
+    // The RPC's transfers are paid back a budget per scan before the layer goes out
+    EXPECT_GT(layer_latency_scans(2, 2 * SPLIT_SCHEDULER_MAX_DEFER_MS, false), 2);
+}
+
+TEST_F(SplitTransportScheduled, DeferralIsBounded) {
+    // Keep the budget spent, so only the deferral limit lets state through
+    uint32_t longest = 0;
+    for (uint8_t layer = 1; layer < 8; layer++) {
+        for (uint32_t i = 0; i < layer * 3; i++) {
+            scan();
+            rpc();
+        }
+        layer_move(layer);
+        uint32_t scans = layer_latency_scans(layer, 2 * SPLIT_SCHEDULER_MAX_DEFER_MS, true);
+        longest        = scans > longest ? scans : longest;
+    }
+    EXPECT_GT(longest, 2);
+    EXPECT_LE(longest, SPLIT_SCHEDULER_MAX_DEFER_MS + 1);
+}
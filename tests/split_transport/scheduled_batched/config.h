@@ -0,0 +1,21 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define SPLIT_LAYER_STATE_ENABLE
+#define SPLIT_MODS_ENABLE
+#define SPLIT_TRANSACTION_IDS_USER USER_ECHO
+#define SPLIT_TRANSACTIONS_BATCHED
+#define SPLIT_TRANSACTIONS_SCHEDULED
+#define DISABLE_SYNC_TIMER
+
+// Long enough that nothing is resent or forced through while a test runs
+#define FORCED_SYNC_THROTTLE_MS 1000
+#define SPLIT_CONNECTION_CHECK_TIMEOUT 500
+#define SPLIT_SCHEDULER_MAX_DEFER_MS 1000
+#define SPLIT_SCHEDULER_TRANSFER_OVERHEAD 2
+// A reply poll and one byte to spare
+#define SPLIT_SCHEDULER_BUDGET 11
@@ -0,0 +1,36 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "split_transport_fixture.hpp"
+
+static_assert(SPLIT_SCHEDULER_BUDGET == sizeof(split_batch_reply_t) + SPLIT_SCHEDULER_TRANSFER_OVERHEAD + 1, "the budget should leave one byte after a reply poll");
+
+class SplitTransportScheduledBatched : public SplitTransport {
+   protected:
+    void TearDown() override {
+        layer_clear();
+        clear_mods();
+        SplitTransport::TearDown();
+    }
+
+    uint32_t transfers(int8_t id) {
+        serial_loopback_stats_t stats;
+        serial_loopback_get_stats(id, &stats);
+        return stats.transfers;
+    }
+};
+
+TEST_F(SplitTransportScheduledBatched, QueuedWritesAreOnlyChargedWithTheirFrame) {
+    // Pay back the forced syncs' frame, so a scan leaves one byte after polling the reply
+    run_for(100);
+
+    uint32_t frames = transfers(PUT_BATCH_FRAME);
+    layer_on(3);
+    set_mods(MOD_BIT(KC_LEFT_SHIFT));
+    // Queuing the layer leaves the byte for the mods, and both go out in the next frame
+    run_for(3);
+
+    EXPECT_EQ(transfers(PUT_BATCH_FRAME) - frames, 1);
+    EXPECT_EQ(serial_loopback_slave_layer_state, (layer_state_t)1 << 3);
+    EXPECT_EQ(serial_loopback_slave_mods.real_mods, MOD_BIT(KC_LEFT_SHIFT));
+}
@@ -0,0 +1,170 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+/* The SplitTransport fixture shared by the split transport tests: both halves over the
+   loopback link, with the master as the left half. Include it from one source file per test. */
+
+#include <cstring>
+#include <iostream>
+#include "test_common.hpp"
+
+extern "C" {
+#include "serial_loopback.h"
+#include "split_util.h"
+#include "transaction_id_define.h"
+#include "transactions.h"
+
+void     set_time(uint32_t t);
+void     advance_time(uint32_t ms);
+uint32_t timer_read32(void);
+
+// Both halves run in this process, this one drives the master side
+bool is_keyboard_master_impl(void) {
+    return true;
+}
+}
+
+#define ROWS_PER_HAND (MATRIX_ROWS / 2)
+
+namespace {
+
+// Each half's own view of the full matrix, the master being the left half
+matrix_row_t master_keyboard[MATRIX_ROWS];
+matrix_row_t slave_keyboard[MATRIX_ROWS];
+
+uint8_t echo_calls;
+
+void echo_slave_handler(uint8_t in_buflen, const void *in_data, uint8_t out_buflen, void *out_data) {
+    const uint8_t *in  = (const uint8_t *)in_data;
+    uint8_t       *out = (uint8_t *)out_data;
+    for (uint8_t i = 0; i < out_buflen && i < in_buflen; i++) {
+        out[i] = in[i] + 1;
+    }
+    echo_calls++;
+}
+
+} // namespace
+
+class SplitTransport : public TestFixture {
+   protected:
+    void SetUp() override {
+        set_time(0);
+        memset(master_keyboard, 0, sizeof(master_keyboard));
+        memset(slave_keyboard, 0, sizeof(slave_keyboard));
+        echo_calls = 0;
+        link(NULL);
+    }
+
+    void link(const serial_loopback_config_t *config) {
+        serial_loopback_reset(config);
+        serial_loopback_slave_register_rpc(USER_ECHO, echo_slave_handler);
+        // Let the forced syncs go out, so each test starts from a settled link
+        run_for(FORCED_SYNC_THROTTLE_MS + 1);
+        serial_loopback_clear_stats();
+    }
+
+    // One scan on each half, a millisecond apart
+    virtual bool scan(void) {
+        serial_loopback_slave_scan(slave_keyboard, slave_keyboard + ROWS_PER_HAND);
+        bool okay = transport_master_if_connected(master_keyboard, master_keyboard + ROWS_PER_HAND);
+        advance_time(1);
+        return okay;
+    }
+
+    void run_for(uint32_t scans) {
+        for (uint32_t i = 0; i < scans; i++) {
+            scan();
+        }
+    }
+
+    void press_on_slave(uint8_t row, uint8_t col) {
+        slave_keyboard[ROWS_PER_HAND + row] |= (matrix_row_t)1 << col;
+    }
+
+    bool master_sees(uint8_t row, uint8_t col) {
+        return master_keyboard[ROWS_PER_HAND + row] & ((matrix_row_t)1 << col);
+    }
+
+    // Milliseconds from a key going down on the slave until the master has it
+    uint32_t key_latency_ms(uint8_t row, uint8_t col, uint32_t limit) {
+        uint32_t start = timer_read32();
+        press_on_slave(row, col);
+        for (uint32_t i = 0; i < limit && !master_sees(row, col); i++) {
+            scan();
+        }
+        EXPECT_TRUE(master_sees(row, col));
+        return timer_read32() - start;
+    }
+
+    uint32_t us_per_byte(const serial_loopback_config_t &config) {
+        return 1000000 / config.bytes_per_second;
+    }
+
+    // Changes everything the master syncs, so each transaction goes over the link at least once
+    void exercise_every_transaction(void) {
+        press_on_slave(0, 1);
+        layer_on(1);
+        default_layer_set((layer_state_t)1 << 2);
+        set_mods(MOD_BIT(KC_LEFT_CTRL));
+        uint8_t request[4] = {0}, response[4];
+        EXPECT_TRUE(transaction_rpc_exec(USER_ECHO, sizeof(request), request, sizeof(response), response));
+#ifdef SPLIT_TRANSACTIONS_ASYNC_RPC
+        EXPECT_TRUE(transaction_rpc_send_async(USER_ECHO, sizeof(request), request));
+#endif
+        run_for(2 * FORCED_SYNC_THROTTLE_MS);
+
+        layer_clear();
+        default_layer_set(1);
+        clear_mods();
+        memset(slave_keyboard, 0, sizeof(slave_keyboard));
+        run_for(2);
+    }
+
+    // Checks that every registered transaction was measured, that each successful transfer
+    // moved its whole buffers and that the link time matches, then prints the throughput of each
+    void expect_every_transaction_measured(const serial_loopback_config_t &config) {
+        for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; id++) {
+            const split_transaction_desc_t *trans = &split_transaction_table[id];
+            if (trans->initiator2target_buffer_size == 0 && trans->target2initiator_buffer_size == 0) {
+                continue;
+            }
+
+            serial_loopback_stats_t stats;
+            serial_loopback_get_stats(id, &stats);
+#ifdef SPLIT_TRANSACTIONS_BATCHED
+            // Queued writes and batched reads travel in the frame and its reply instead
+            if (stats.transfers == 0 && id != PUT_BATCH_FRAME && id != GET_BATCH_REPLY) {
+                continue;
+            }
+#endif
+            EXPECT_GT(stats.transfers, 0) << "transaction " << +id;
+            if (stats.transfers == 0) {
+                continue;
+            }
+#if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+            // Only the requested length of the RPC buffers is sent
+            bool variable = id == PUT_RPC_REQ_DATA || id == GET_RPC_RESP_DATA;
+#else
+            bool variable = false;
+#endif
+#ifdef SPLIT_TRANSACTIONS_BATCHED
+            // Frames only go out as far as their length
+            bool partial_out = id == PUT_BATCH_FRAME;
+#else
+            bool partial_out = false;
+#endif
+            if (!variable && stats.failures == 0) {
+                if (partial_out) {
+                    EXPECT_LT(stats.bytes_out, stats.transfers * trans->initiator2target_buffer_size) << "transaction " << +id;
+                } else {
+                    EXPECT_EQ(stats.bytes_out, stats.transfers * trans->initiator2target_buffer_size) << "transaction " << +id;
+                }
+                EXPECT_EQ(stats.bytes_in, stats.transfers * trans->target2initiator_buffer_size) << "transaction " << +id;
+                EXPECT_EQ(stats.link_time_us, stats.transfers * config.latency_us + (stats.bytes_out + stats.bytes_in) * us_per_byte(config)) << "transaction " << +id;
+            }
+            std::cout << "[ TRACE    ] transaction " << +id << ": " << stats.transfers << " transfers, " << stats.bytes_out << "/" << stats.bytes_in << " bytes out/in, " << stats.link_time_us / stats.transfers << " us/transfer" << std::endl;
+        }
+    }
+};
@@ -0,0 +1,9 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+SPLIT_KEYBOARD = yes
+SERIAL_DRIVER = loopback
+SPLIT_TELEMETRY_ENABLE = yes
+
+# The split fixture
+VPATH += $(TOP_DIR)/tests/split_transport
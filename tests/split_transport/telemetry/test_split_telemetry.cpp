@@ -0,0 +1,83 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "split_transport_fixture.hpp"
+
+extern "C" {
+#include "split_telemetry.h"
+}
+
+class SplitTelemetry : public SplitTransport {
+   protected:
+    void SetUp() override {
+        SplitTransport::SetUp();
+        split_telemetry_reset();
+    }
+
+    // Which bucket the round trips of `id` went into, or -1 if they were spread out
+    int8_t only_bucket(int8_t id) {
+        int8_t only = -1;
+        for (uint8_t bucket = 0; bucket < split_telemetry_rtt_buckets(); bucket++) {
+            if (split_telemetry_get_histogram_bucket(id, bucket) > 0) {
+                if (only >= 0) {
+                    return -1;
+                }
+                only = bucket;
+            }
+        }
+        return only;
+    }
+};
+
+TEST_F(SplitTelemetry, CountsMatchTheLink) {
+    serial_loopback_config_t config = {.bytes_per_second = 960};
+    link(&config);
+    split_telemetry_reset();
+
+    key_latency_ms(0, 2, 100);
+    run_for(2 * FORCED_SYNC_THROTTLE_MS);
+
+    for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; id++) {
+        serial_loopback_stats_t link_stats;
+        split_telemetry_stats_t stats;
+        serial_loopback_get_stats(id, &link_stats);
+        split_telemetry_get_stats(id, &stats);
+        EXPECT_EQ(stats.transfers + stats.failures, link_stats.transfers) << "transaction " << (int)id;
+        EXPECT_EQ(stats.bytes_out, link_stats.bytes_out) << "transaction " << (int)id;
+        EXPECT_EQ(stats.bytes_in, link_stats.bytes_in) << "transaction " << (int)id;
+    }
+}
+
+TEST_F(SplitTelemetry, RoundTripsAreReportedInMicroseconds) {
+    serial_loopback_config_t config = {.latency_us = 3000};
+    link(&config);
+    split_telemetry_reset();
+
+    run_for(10);
+
+    split_telemetry_stats_t stats;
+    split_telemetry_get_stats(GET_SLAVE_MATRIX_CHECKSUM, &stats);
+    EXPECT_EQ(stats.transfers, 10);
+    EXPECT_EQ(stats.rtt_min_us, config.latency_us);
+    EXPECT_EQ(stats.rtt_avg_us, config.latency_us);
+    EXPECT_EQ(stats.rtt_max_us, config.latency_us);
+
+    // Filed under the first bound it does not exceed
+    int8_t expected = 0;
+    while (expected < split_telemetry_rtt_buckets() - 1 && split_telemetry_rtt_bound(expected) < config.latency_us) {
+        expected++;
+    }
+    EXPECT_EQ(only_bucket(GET_SLAVE_MATRIX_CHECKSUM), expected);
+}
+
+TEST_F(SplitTelemetry, LongRoundTripsDoNotWrapTheAverage) {
+    split_telemetry_record_transfer(USER_ECHO, true, 1, 0, 0);
+    split_telemetry_record_transfer(USER_ECHO, true, UINT32_MAX, 0, 0);
+
+    split_telemetry_stats_t stats;
+    split_telemetry_get_stats(USER_ECHO, &stats);
+    EXPECT_EQ(stats.transfers, 2);
+    EXPECT_EQ(stats.rtt_min_us, 1000000 / 1000);
+    EXPECT_EQ(stats.rtt_avg_us, UINT16_MAX);
+    EXPECT_EQ(stats.rtt_max_us, UINT16_MAX);
+}
@@ -0,0 +1,143 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "split_transport_fixture.hpp"
+
+TEST_F(SplitTransport, IdealLinkDeliversKeyOnTheNextScan) {
+    EXPECT_LE(key_latency_ms(1, 3, 10), 1);
+    EXPECT_EQ(serial_loopback_link_time_us(), 0);
+}
+
+TEST_F(SplitTransport, IdleSyncOnlyPollsTheMatrixChecksum) {
+    const uint32_t scans = 10 * FORCED_SYNC_THROTTLE_MS;
+    run_for(scans);
+
+    serial_loopback_stats_t checksum, data;
+    serial_loopback_get_stats(GET_SLAVE_MATRIX_CHECKSUM, &checksum);
+    serial_loopback_get_stats(GET_SLAVE_MATRIX_DATA, &data);
+    EXPECT_EQ(checksum.transfers, scans);
+    EXPECT_EQ(checksum.bytes_in, scans);
+    EXPECT_EQ(checksum.failures, 0);
+    // The full matrix only goes over the link on the forced resync
+    EXPECT_LE(data.transfers, scans / FORCED_SYNC_THROTTLE_MS + 1);
+    EXPECT_EQ(data.bytes_in, data.transfers * ROWS_PER_HAND * sizeof(matrix_row_t));
+
+    uint32_t total_bytes = 0;
+    for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; id++) {
+        serial_loopback_stats_t stats;
+        serial_loopback_get_stats(id, &stats);
+        total_bytes += stats.bytes_out + stats.bytes_in;
+    }
+    // Per-sync throughput: the checksum byte, plus the periodic resyncs spread over each scan
+    EXPECT_LT(total_bytes, 2 * scans);
+}
+
+TEST_F(SplitTransport, EverySyncTransactionIsMeasured) {
+    serial_loopback_config_t config = {.bytes_per_second = 1000, .latency_us = 50};
+    link(&config);
+
+    exercise_every_transaction();
+    expect_every_transaction_measured(config);
+}
+
+TEST_F(SplitTransport, SlowLinkAddsTransferTimeToKeyLatency) {
+    // 9600 baud
+    serial_loopback_config_t config = {.bytes_per_second = 960, .latency_us = 100};
+    link(&config);
+
+    uint32_t latency_ms = key_latency_ms(0, 0, 100);
+
+    // The checksum poll that spots the change, then the matrix itself
+    uint32_t transfer_us = 2 * config.latency_us + (1 + ROWS_PER_HAND * sizeof(matrix_row_t)) * us_per_byte(config);
+    EXPECT_GE(latency_ms, transfer_us / 1000);
+    EXPECT_LE(latency_ms, transfer_us / 1000 + 2);
+}
+
+TEST_F(SplitTransport, HighLatencyLinkDelaysEveryTransfer) {
+    serial_loopback_config_t config = {.latency_us = 3000};
+    link(&config);
+
+    serial_loopback_stats_t before;
+    serial_loopback_get_stats(GET_SLAVE_MATRIX_CHECKSUM, &before);
+    uint32_t latency_ms = key_latency_ms(1, 9, 100);
+
+    serial_loopback_stats_t after;
+    serial_loopback_get_stats(GET_SLAVE_MATRIX_CHECKSUM, &after);
+    EXPECT_EQ(after.transfers - before.transfers, 1);
+    EXPECT_GE(latency_ms, 2 * config.latency_us / 1000);
+    EXPECT_LE(latency_ms, 2 * config.latency_us / 1000 + 1);
+}
+
+TEST_F(SplitTransport, BitFlipsNeverProduceKeys) {
+    serial_loopback_config_t config = {.flip_ppm = 20000, .seed = 0x5eed};
+    link(&config);
+
+    uint32_t phantom_scans = 0;
+    for (uint32_t i = 0; i < 5000; i++) {
+        scan();
+        for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+            if (master_keyboard[ROWS_PER_HAND + row]) {
+                phantom_scans++;
+            }
+        }
+    }
+    EXPECT_EQ(phantom_scans, 0);
+
+    // The damaged checksums made the master fetch the matrix, and then throw it away
+    serial_loopback_stats_t data;
+    serial_loopback_get_stats(GET_SLAVE_MATRIX_DATA, &data);
+    EXPECT_GT(data.transfers, 5000 / FORCED_SYNC_THROTTLE_MS + 1);
+}
+
+TEST_F(SplitTransport, DroppedBytesAreRetriedOnLaterScans) {
+    serial_loopback_config_t config = {.timeout_us = 1000, .drop_ppm = 100000, .seed = 42};
+    link(&config);
+
+    key_latency_ms(0, 4, 100);
+    run_for(1000);
+
+    serial_loopback_stats_t checksum;
+    serial_loopback_get_stats(GET_SLAVE_MATRIX_CHECKSUM, &checksum);
+    EXPECT_GT(checksum.failures, 0);
+    EXPECT_LT(checksum.failures, checksum.transfers);
+    EXPECT_TRUE(is_transport_connected());
+    EXPECT_TRUE(master_sees(0, 4));
+}
+
+TEST_F(SplitTransport, LostLinkDisconnects) {
+    serial_loopback_config_t config = {.timeout_us = 1000, .drop_ppm = 1000000};
+    serial_loopback_reset(&config);
+
+    run_for(100);
+    EXPECT_FALSE(is_transport_connected());
+
+    // Every failed poll waited out the timeout
+    serial_loopback_stats_t checksum;
+    serial_loopback_get_stats(GET_SLAVE_MATRIX_CHECKSUM, &checksum);
+    EXPECT_GT(checksum.failures, 0);
+    EXPECT_GE(checksum.link_time_us, checksum.failures * config.timeout_us);
+
+    link(NULL);
+    run_for(SPLIT_CONNECTION_CHECK_TIMEOUT + 1);
+    EXPECT_TRUE(is_transport_connected());
+}
+
+TEST_F(SplitTransport, RpcRoundTrip) {
+    serial_loopback_config_t config = {.bytes_per_second = 960};
+    link(&config);
+
+    uint8_t request[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    uint8_t response[8];
+    ASSERT_TRUE(transaction_rpc_exec(USER_ECHO, sizeof(request), request, sizeof(response), response));
+    EXPECT_EQ(echo_calls, 1);
+    for (uint8_t i = 0; i < sizeof(request); i++) {
+        EXPECT_EQ(response[i], request[i] + 1);
+    }
+
+    serial_loopback_stats_t request_data, response_data;
+    serial_loopback_get_stats(PUT_RPC_REQ_DATA, &request_data);
+    serial_loopback_get_stats(GET_RPC_RESP_DATA, &response_data);
+    EXPECT_EQ(request_data.bytes_out, sizeof(request));
+    EXPECT_EQ(response_data.bytes_in, sizeof(response));
+    EXPECT_GE(serial_loopback_link_time_us(), (sizeof(request) + sizeof(response)) * us_per_byte(config));
+}
@@ -0,0 +1,163 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "trace_replay.hpp"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include "gmock/gmock.h"
+#include "test_matrix.h"
+
+extern "C" {
+#include "action.h"
+#include "action_tapping.h"
+#include "keyboard.h"
+
+void advance_time(uint32_t ms);
+}
+
+using testing::_;
+
+namespace {
+
+/* Small self-contained PRNG, so that a seed produces the same trace with every standard library */
+class TraceRandom {
+   public:
+    explicit TraceRandom(uint32_t seed) : m_state(seed ? seed : 1) {}
+
+    uint32_t next() {
+        m_state ^= m_state << 13;
+        m_state ^= m_state >> 17;
+        m_state ^= m_state << 5;
+        return m_state;
+    }
+
+    uint32_t uniform(uint32_t range) {
+        return range ? next() % range : 0;
+    }
+
+    /* Roughly bell-shaped around range / 2 */
+    uint32_t bell(uint32_t range) {
+        return (uniform(range + 1) + uniform(range + 1) + uniform(range + 1) + uniform(range + 1)) / 4;
+    }
+
+   private:
+    uint32_t m_state;
+};
+
+struct TimedEvent {
+    uint32_t time;
+    size_t   order;
+    uint8_t  col;
+    uint8_t  row;
+    bool     pressed;
+};
+
+} // namespace
+
+Trace trace_generate(const std::vector<TraceStroke>& strokes, size_t count, uint32_t seed) {
+    TraceRandom rng(seed);
+    unsigned    total_weight = 0;
+    for (const auto& stroke : strokes) {
+        total_weight += stroke.weight;
+    }
+
+    std::vector<TimedEvent>                         timed;
+    std::map<std::pair<uint8_t, uint8_t>, uint32_t> free_at;
+    uint32_t                                        now = 0;
+    for (size_t i = 0; i < count && total_weight > 0; i++) {
+        unsigned pick = rng.uniform(total_weight);
+        auto     it   = strokes.begin();
+        while (pick >= it->weight) {
+            pick -= it->weight;
+            ++it;
+        }
+
+        // ~150ms between keystrokes, and now and then a pause to think
+        now += 60 + rng.bell(180);
+        if (rng.uniform(50) == 0) {
+            now += 400 + rng.uniform(1100);
+        }
+
+        uint32_t press_time = now;
+        for (const auto& key : it->keys) {
+            // A key can only go down again once it has been released
+            press_time        = std::max(press_time, free_at[key]);
+            uint32_t hold     = it->hold_ms ? it->hold_ms + rng.uniform(100) : 50 + rng.bell(80);
+            uint32_t released = press_time + hold;
+            free_at[key]      = released + 1;
+            timed.push_back({press_time, timed.size(), key.first, key.second, true});
+            timed.push_back({released, timed.size(), key.first, key.second, false});
+            // Chorded keys land within a few milliseconds of each other
+            press_time += rng.uniform(8);
+        }
+    }
+
+    std::sort(timed.begin(), timed.end(), [](const TimedEvent& a, const TimedEvent& b) { return a.time != b.time ? a.time < b.time : a.order < b.order; });
+
+    Trace    trace;
+    uint32_t last = 0;
+    for (const auto& event : timed) {
+        trace.push_back({event.time - last, event.col, event.row, event.pressed});
+        last = event.time;
+    }
+    return trace;
+}
+
+Trace trace_load(const std::string& path) {
+    Trace         trace;
+    std::ifstream file(path);
+    std::string   line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream fields(line);
+        unsigned           delay, col, row;
+        char               state;
+        if (fields >> delay >> col >> row >> state && col < MATRIX_COLS && row < MATRIX_ROWS) {
+            trace.push_back({delay, uint8_t(col), uint8_t(row), state == 'p'});
+        }
+    }
+    return trace;
+}
+
+TraceReplayStats TraceReplay::replay(TestDriver& driver, const Trace& trace) {
+    TraceReplayStats stats;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).WillRepeatedly(testing::InvokeWithoutArgs([&stats]() { stats.reports++; }));
+
+    // Drive keyboard_task() directly rather than through idle_for(), to keep the test logger out of the measurement
+    auto scan = [&stats]() {
+        keyboard_task();
+        advance_time(1);
+        stats.scans++;
+#ifndef NO_ACTION_TAPPING
+        stats.peak_waiting_buffer = std::max(stats.peak_waiting_buffer, action_tapping_waiting_buffer_count());
+#endif
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& event : trace) {
+        for (uint32_t i = 0; i < event.delay_ms; i++) {
+            scan();
+        }
+        if (event.pressed) {
+            press_key(event.col, event.row);
+        } else {
+            release_key(event.col, event.row);
+        }
+        stats.events++;
+    }
+    scan();
+    stats.elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    testing::Mock::VerifyAndClearExpectations(&driver);
+    return stats;
+}
+
+void TraceReplay::print_stats(const std::string& name, const TraceReplayStats& stats) const {
+    std::cout << "[ TRACE    ] " << name << ": " << stats.events << " events, " << stats.scans << " scans, " << uint64_t(stats.ns_per_event()) << " ns/event, " << stats.reports << " reports, peak waiting buffer " << +stats.peak_waiting_buffer << std::endl;
+}
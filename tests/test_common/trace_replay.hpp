@@ -0,0 +1,78 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "test_driver.hpp"
+#include "test_fixture.hpp"
+
+/**
+ * @brief A single matrix transition of a keystroke trace, `delay_ms` after the previous one.
+ */
+struct TraceEvent {
+    uint32_t delay_ms;
+    uint8_t  col;
+    uint8_t  row;
+    bool     pressed;
+};
+
+using Trace = std::vector<TraceEvent>;
+
+/**
+ * @brief One kind of keystroke the trace generator can emit.
+ *
+ * All `keys` are pressed together (a chord when there is more than one), as positions of
+ * {col, row}. With a non-zero `hold_ms` the keys are held that long while typing carries
+ * on, like a held modifier or layer key, otherwise they are tapped with a typical typing
+ * hold time.
+ */
+struct TraceStroke {
+    std::vector<std::pair<uint8_t, uint8_t>> keys;
+    unsigned                                 weight;
+    uint16_t                                 hold_ms = 0;
+};
+
+/**
+ * @brief Generates `count` strokes of pseudo-random typing, deterministic for a given `seed`.
+ *
+ * Inter-key intervals and hold times follow typing at roughly 80 words per minute, so
+ * consecutive keys regularly roll over each other, with an occasional pause.
+ */
+Trace trace_generate(const std::vector<TraceStroke>& strokes, size_t count, uint32_t seed);
+
+/**
+ * @brief Loads a recorded trace, one event per line as `<delay_ms> <col> <row> <p|r>`.
+ *
+ * Empty lines and lines starting with `#` are skipped. Returns an empty trace if the file can't be read.
+ */
+Trace trace_load(const std::string& path);
+
+struct TraceReplayStats {
+    size_t   events              = 0;
+    size_t   scans               = 0;
+    size_t   reports             = 0;
+    uint8_t  peak_waiting_buffer = 0;
+    uint64_t elapsed_ns          = 0;
+
+    double ns_per_event() const {
+        return events ? double(elapsed_ns) / events : 0;
+    }
+};
+
+/**
+ * @brief Test fixture replaying keystroke traces through the matrix, one keyboard_task() per millisecond.
+ */
+class TraceReplay : public TestFixture {
+   public:
+    /**
+     * @brief Replays `trace`, counting the keyboard reports sent to `driver`.
+     *
+     * Only the replay itself is timed, the fixture's usual clean-up idling is not.
+     */
+    TraceReplayStats replay(TestDriver& driver, const Trace& trace);
+
+    void print_stats(const std::string& name, const TraceReplayStats& stats) const;
+};
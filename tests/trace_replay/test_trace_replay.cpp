@@ -0,0 +1,130 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstdlib>
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+#include "trace_replay.hpp"
+#include "trace_baseline.h"
+
+using testing::_;
+
+#define TRACE_REPLAY_STROKES 4000
+#define TRACE_REPLAY_SEED 0x5eed
+
+class TraceReplayBenchmark : public TraceReplay {
+   protected:
+    void SetUp() override {
+        static const uint16_t layer0[MATRIX_ROWS][MATRIX_COLS] = {
+            {KC_Q, KC_W, KC_E, KC_R, KC_T, KC_Y, KC_U, KC_I, KC_O, KC_P},
+            {LGUI_T(KC_A), LALT_T(KC_S), LCTL_T(KC_D), LSFT_T(KC_F), KC_G, KC_H, RSFT_T(KC_J), RCTL_T(KC_K), RALT_T(KC_L), RGUI_T(KC_SCLN)},
+            {KC_Z, KC_X, KC_C, KC_V, KC_B, KC_N, KC_M, KC_COMM, KC_DOT, KC_SLSH},
+            {TD(0), KC_LSFT, LT(1, KC_SPC), KC_BSPC, CW_TOGG, KC_ENT, KC_NO, KC_NO, KC_NO, KC_NO},
+        };
+        static const uint16_t numbers[MATRIX_COLS] = {KC_1, KC_2, KC_3, KC_4, KC_5, KC_6, KC_7, KC_8, KC_9, KC_0};
+
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                add_key(KeymapKey(0, col, row, layer0[row][col]));
+            }
+        }
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                add_key(KeymapKey(1, col, row, row == 0 ? numbers[col] : KC_TRNS));
+            }
+        }
+    }
+
+    /* Mostly letters and space, with chords, held modifiers, layer holds and the odd tap dance */
+    static std::vector<TraceStroke> typing_strokes() {
+        std::vector<TraceStroke> strokes;
+        for (uint8_t row = 0; row < 3; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                strokes.push_back({{{col, row}}, 3});
+            }
+        }
+        strokes.push_back({{{2, 3}}, 18});        // space
+        strokes.push_back({{{3, 3}}, 4});         // backspace
+        strokes.push_back({{{5, 3}}, 2});         // enter
+        strokes.push_back({{{0, 3}}, 2});         // tap dance
+        strokes.push_back({{{4, 3}}, 1});         // caps word
+        strokes.push_back({{{1, 0}, {2, 0}}, 2}); // W+E combo
+        strokes.push_back({{{2, 2}, {3, 2}}, 2}); // C+V combo
+        strokes.push_back({{{1, 3}}, 3, 400});    // held shift, shift+backspace hits the key override
+        strokes.push_back({{{2, 3}}, 3, 300});    // held layer key
+        strokes.push_back({{{3, 1}}, 2, 300});    // held home row mod
+        return strokes;
+    }
+
+    static uint64_t env_or(const char* name, uint64_t fallback) {
+        const char* value = std::getenv(name);
+        return value ? std::strtoull(value, nullptr, 0) : fallback;
+    }
+};
+
+TEST_F(TraceReplayBenchmark, GeneratorIsDeterministicAndBalanced) {
+    Trace a = trace_generate(typing_strokes(), 200, TRACE_REPLAY_SEED);
+    Trace b = trace_generate(typing_strokes(), 200, TRACE_REPLAY_SEED);
+
+    ASSERT_EQ(a.size(), b.size());
+    int pressed = 0;
+    for (size_t i = 0; i < a.size(); i++) {
+        EXPECT_EQ(a[i].delay_ms, b[i].delay_ms);
+        EXPECT_EQ(a[i].col, b[i].col);
+        EXPECT_EQ(a[i].row, b[i].row);
+        EXPECT_EQ(a[i].pressed, b[i].pressed);
+        pressed += a[i].pressed ? 1 : -1;
+        EXPECT_GE(pressed, 0);
+    }
+    EXPECT_EQ(pressed, 0);
+}
+
+TEST_F(TraceReplayBenchmark, FeatureStackThroughput) {
+    TestDriver driver;
+    Trace      trace = trace_generate(typing_strokes(), TRACE_REPLAY_STROKES, TRACE_REPLAY_SEED);
+
+    // Replay once with the runtime-switchable features off to see what stacking them costs
+    combo_disable();
+    key_override_off();
+    autoshift_disable();
+    TraceReplayStats bare = replay(driver, trace);
+    print_stats("bare", bare);
+    combo_enable();
+    key_override_on();
+    autoshift_enable();
+
+    idle_for(TAPPING_TERM * 10);
+    TraceReplayStats stacked = replay(driver, trace);
+    print_stats("feature stack", stacked);
+
+    EXPECT_EQ(stacked.events, trace.size());
+    EXPECT_EQ(stacked.scans, TRACE_REPLAY_BASELINE_SCANS);
+    EXPECT_EQ(stacked.reports, TRACE_REPLAY_BASELINE_REPORTS);
+    EXPECT_EQ(stacked.peak_waiting_buffer, TRACE_REPLAY_BASELINE_PEAK_WAITING_BUFFER);
+
+    if (!std::getenv("TRACE_REPLAY_TIMING")) {
+        return;
+    }
+    uint64_t baseline = env_or("TRACE_REPLAY_BASELINE_NS", TRACE_REPLAY_BASELINE_NS_PER_EVENT);
+    uint64_t percent  = env_or("TRACE_REPLAY_MAX_REGRESSION", TRACE_REPLAY_MAX_REGRESSION_PERCENT);
+    if (baseline > 0) {
+        EXPECT_LE(stacked.ns_per_event(), baseline * (100 + percent) / 100.0) << "throughput regressed more than " << percent << "% past the baseline of " << baseline << " ns/event";
+    }
+}
+
+TEST_F(TraceReplayBenchmark, RecordedTrace) {
+    const char* path = std::getenv("TRACE_REPLAY_FILE");
+    if (!path) {
+        GTEST_SKIP() << "set TRACE_REPLAY_FILE to replay a recorded trace";
+    }
+
+    TestDriver driver;
+    Trace      trace = trace_load(path);
+    ASSERT_FALSE(trace.empty()) << "could not load " << path;
+
+    TraceReplayStats stats = replay(driver, trace);
+    print_stats(path, stats);
+    EXPECT_EQ(stats.events, trace.size());
+}
@@ -0,0 +1,19 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+/* What replaying the generated trace through the full feature stack produces. These only
+   change with the trace generator or the behaviour of a feature in the stack, so update
+   them along with any such change. */
+#define TRACE_REPLAY_BASELINE_SCANS 677098
+#define TRACE_REPLAY_BASELINE_REPORTS 7830
+#define TRACE_REPLAY_BASELINE_PEAK_WAITING_BUFFER 3
+
+/* ns/event of the same replay, as measured on a development machine. Wall-clock time depends
+   on the machine and its load, so it is only checked when TRACE_REPLAY_TIMING is set.
+   TRACE_REPLAY_BASELINE_NS overrides it when timing on much slower hardware. */
+#define TRACE_REPLAY_BASELINE_NS_PER_EVENT 50000
+
+/* How much slower than the baseline the replay may get before a timed run fails */
+#define TRACE_REPLAY_MAX_REGRESSION_PERCENT 100
@@ -0,0 +1,12 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define EEPROM_TEST_HARNESS_SIZE 1024
+#define DYNAMIC_KEYMAP_LAYER_COUNT 2
+
+#define RGB_MATRIX_LED_COUNT (MATRIX_ROWS * MATRIX_COLS)
+#define VIALRGB_DIRECT_STREAM
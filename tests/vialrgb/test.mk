@@ -0,0 +1,12 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+RGB_MATRIX_ENABLE = yes
+RGB_MATRIX_DRIVER = custom
+DYNAMIC_KEYMAP_ENABLE = yes
+
+# vialrgb.c is built for Vial, vial_stubs.cpp stands in for vial.c
+OPT_DEFS += -DVIAL_ENABLE -DVIALRGB_ENABLE
+SRC += $(QUANTUM_DIR)/vialrgb.c
+
+VPATH += $(TOP_DIR)/tests/dynamic_keymap $(TOP_DIR)/tests/rgb_matrix
@@ -0,0 +1,225 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include <initializer_list>
+#include <vector>
+#include "test_common.hpp"
+#include "rgb_matrix_test_leds.hpp"
+
+// vialrgb.c is built for Vial, the dynamic keymap tests have the stand-ins for vial.c
+#include "vial_stubs.cpp"
+
+extern "C" {
+#include "via.h"
+#include "vialrgb.h"
+
+const uint16_t* vialrgb_direct_stream_frame(void);
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = memory_init,
+    .set_color     = memory_set_color,
+    .set_color_all = memory_set_color_all,
+    .flush         = memory_flush,
+};
+}
+
+static const uint16_t RED   = 0xF800;
+static const uint16_t GREEN = 0x07E0;
+static const uint16_t BLUE  = 0x001F;
+static const uint16_t WHITE = 0xFFFF;
+
+struct StreamStatus {
+    uint8_t  last_seq;
+    uint16_t completed;
+    uint16_t dropped;
+};
+
+class VialRgbStream : public TestFixture {
+   protected:
+    void SetUp() override {
+        set_time(0);
+        rgb_matrix_init();
+        rgb_matrix_mode_noeeprom(RGB_MATRIX_VIALRGB_DIRECT);
+        // Selecting the effect drops back to the fastset colors, so the host streams once it is running
+        render_frame();
+        before = status();
+    }
+
+    // One vialrgb_direct_stream packet, `count` is the number of LEDs or, for deltas, records
+    void packet(uint8_t seq, uint8_t index, uint8_t flags, uint16_t led, uint8_t count, std::initializer_list<uint8_t> payload) {
+        uint8_t data[VIAL_RAW_EPSIZE] = {id_lighting_set_value, vialrgb_direct_stream, seq, index, flags, (uint8_t)(led & 0xFF), (uint8_t)(led >> 8), count};
+        std::copy(payload.begin(), payload.end(), &data[8]);
+        EXPECT_TRUE(vialrgb_handle_stream(data, sizeof(data)));
+    }
+
+    void rgb565_packet(uint8_t seq, uint8_t index, bool last, uint16_t led, const std::vector<uint16_t>& colors) {
+        uint8_t data[VIAL_RAW_EPSIZE] = {id_lighting_set_value, vialrgb_direct_stream, seq, index, (uint8_t)(VIALRGB_STREAM_RGB565 | (last ? VIALRGB_STREAM_LAST : 0)), (uint8_t)(led & 0xFF), (uint8_t)(led >> 8), (uint8_t)colors.size()};
+        for (size_t i = 0; i < colors.size(); i++) {
+            data[8 + i * 2]     = colors[i] & 0xFF;
+            data[8 + i * 2 + 1] = colors[i] >> 8;
+        }
+        EXPECT_TRUE(vialrgb_handle_stream(data, sizeof(data)));
+    }
+
+    // A whole frame of one color, 12 LEDs per packet
+    void solid_frame(uint8_t seq, uint16_t color) {
+        uint8_t index = 0;
+        for (uint16_t led = 0; led < RGB_MATRIX_LED_COUNT; led += 12, index++) {
+            uint8_t count = RGB_MATRIX_LED_COUNT - led < 12 ? RGB_MATRIX_LED_COUNT - led : 12;
+            rgb565_packet(seq, index, led + count == RGB_MATRIX_LED_COUNT, led, std::vector<uint16_t>(count, color));
+        }
+    }
+
+    StreamStatus status(void) {
+        uint8_t data[VIAL_RAW_EPSIZE] = {id_lighting_get_value, vialrgb_get_stream_status};
+        vialrgb_get_value(data, sizeof(data));
+        return {data[2], (uint16_t)(data[3] | (data[4] << 8)), (uint16_t)(data[5] | (data[6] << 8))};
+    }
+
+    // Runs the task until a whole frame has been rendered and flushed
+    void render_frame(void) {
+        uint32_t target = flush_count + 1;
+        for (int guard = 0; flush_count < target && guard < 1000; guard++) {
+            rgb_matrix_task();
+            advance_time(1);
+        }
+        ASSERT_GE(flush_count, target);
+    }
+
+    static RGB expanded(uint16_t c) {
+        return {(uint8_t)(((c >> 8) & 0xF8) | (c >> 13)), (uint8_t)(((c >> 3) & 0xFC) | ((c >> 9) & 0x03)), (uint8_t)(((c << 3) & 0xF8) | ((c >> 2) & 0x07))};
+    }
+
+    static void expect_flushed(uint8_t led, uint16_t color) {
+        RGB rgb = expanded(color);
+        EXPECT_EQ(flushed[led].r, rgb.r) << "LED " << (int)led;
+        EXPECT_EQ(flushed[led].g, rgb.g) << "LED " << (int)led;
+        EXPECT_EQ(flushed[led].b, rgb.b) << "LED " << (int)led;
+    }
+
+    StreamStatus before;
+};
+
+TEST_F(VialRgbStream, AppliesFramesInOrder) {
+    solid_frame(1, RED);
+    StreamStatus after = status();
+    EXPECT_EQ(after.last_seq, 1);
+    EXPECT_EQ(after.completed, before.completed + 1);
+    EXPECT_EQ(after.dropped, before.dropped);
+
+    render_frame();
+    for (uint8_t led = 0; led < RGB_MATRIX_LED_COUNT; led++) {
+        expect_flushed(led, RED);
+    }
+
+    // Nothing shows until the last packet of the next frame is in
+    rgb565_packet(2, 0, false, 0, std::vector<uint16_t>(12, GREEN));
+    render_frame();
+    expect_flushed(0, RED);
+
+    rgb565_packet(2, 1, true, 12, std::vector<uint16_t>(12, BLUE));
+    render_frame();
+    for (uint8_t led = 0; led < RGB_MATRIX_LED_COUNT; led++) {
+        // LEDs the frame leaves out keep their color from the frame before
+        expect_flushed(led, led < 12 ? GREEN : led < 24 ? BLUE : RED);
+    }
+    EXPECT_EQ(status().last_seq, 2);
+    EXPECT_EQ(status().completed, before.completed + 2);
+}
+
+TEST_F(VialRgbStream, DropsFramesMissingAPacket) {
+    solid_frame(10, RED);
+
+    // Packet 1 never arrives, the rest of frame 11 is thrown away
+    rgb565_packet(11, 0, false, 0, std::vector<uint16_t>(12, GREEN));
+    rgb565_packet(11, 2, false, 24, std::vector<uint16_t>(12, GREEN));
+    rgb565_packet(11, 3, true, 36, std::vector<uint16_t>(4, GREEN));
+
+    StreamStatus after = status();
+    EXPECT_EQ(after.last_seq, 10);
+    EXPECT_EQ(after.completed, before.completed + 1);
+    EXPECT_EQ(after.dropped, before.dropped + 1);
+
+    render_frame();
+    for (uint8_t led = 0; led < RGB_MATRIX_LED_COUNT; led++) {
+        expect_flushed(led, RED);
+    }
+
+    // The next frame starts over from the last complete one
+    rgb565_packet(12, 0, true, 0, {BLUE});
+    render_frame();
+    expect_flushed(0, BLUE);
+    expect_flushed(1, RED);
+    expect_flushed(24, RED);
+    EXPECT_EQ(status().last_seq, 12);
+    EXPECT_EQ(status().dropped, before.dropped + 1);
+}
+
+TEST_F(VialRgbStream, NewSequenceNumberSupersedesAPartialFrame) {
+    solid_frame(20, RED);
+
+    // Frame 21 is cut short by frame 22, whose packets arrive out of order
+    rgb565_packet(21, 0, false, 0, std::vector<uint16_t>(12, GREEN));
+    rgb565_packet(22, 1, true, 12, std::vector<uint16_t>(12, BLUE));
+    rgb565_packet(22, 0, false, 0, std::vector<uint16_t>(12, BLUE));
+    EXPECT_EQ(status().last_seq, 20);
+    EXPECT_EQ(status().dropped, before.dropped + 2);
+
+    // The frame 22 restarted from its first packet is cut short by 23 in turn, which makes it through
+    rgb565_packet(23, 0, false, 0, std::vector<uint16_t>(12, WHITE));
+    rgb565_packet(23, 1, true, 12, std::vector<uint16_t>(12, WHITE));
+    StreamStatus after = status();
+    EXPECT_EQ(after.last_seq, 23);
+    EXPECT_EQ(after.completed, before.completed + 2);
+    EXPECT_EQ(after.dropped, before.dropped + 3);
+
+    render_frame();
+    for (uint8_t led = 0; led < RGB_MATRIX_LED_COUNT; led++) {
+        expect_flushed(led, led < 24 ? WHITE : RED);
+    }
+}
+
+TEST_F(VialRgbStream, DeltaFramesOnlyChangeTheLedsTheyName) {
+    solid_frame(30, RED);
+
+    // Records of [skip] [RGB565]: LED 2, LED 3 and LED 10
+    packet(31, 0, VIALRGB_STREAM_DELTA | VIALRGB_STREAM_LAST, 0, 3, {2, GREEN & 0xFF, GREEN >> 8, 0, BLUE & 0xFF, BLUE >> 8, 6, WHITE & 0xFF, WHITE >> 8});
+    render_frame();
+    for (uint8_t led = 0; led < RGB_MATRIX_LED_COUNT; led++) {
+        expect_flushed(led, led == 2 ? GREEN : led == 3 ? BLUE : led == 10 ? WHITE : RED);
+    }
+
+    // Deltas build on the newest complete frame, not on the one shown
+    packet(32, 0, VIALRGB_STREAM_DELTA | VIALRGB_STREAM_LAST, 5, 1, {0, BLUE & 0xFF, BLUE >> 8});
+    packet(33, 0, VIALRGB_STREAM_DELTA | VIALRGB_STREAM_LAST, 6, 1, {0, BLUE & 0xFF, BLUE >> 8});
+    render_frame();
+    expect_flushed(5, BLUE);
+    expect_flushed(6, BLUE);
+    expect_flushed(2, GREEN);
+    expect_flushed(7, RED);
+}
+
+TEST_F(VialRgbStream, IgnoresLedsOutOfRange) {
+    solid_frame(40, RED);
+    const uint16_t* frame = vialrgb_direct_stream_frame();
+    ASSERT_NE(frame, nullptr);
+
+    // Only the first two of these fit, then a packet that starts past the last LED
+    rgb565_packet(41, 0, false, RGB_MATRIX_LED_COUNT - 2, std::vector<uint16_t>(12, GREEN));
+    rgb565_packet(41, 1, false, RGB_MATRIX_LED_COUNT, std::vector<uint16_t>(12, BLUE));
+    rgb565_packet(41, 2, false, 0xFFFF, std::vector<uint16_t>(12, BLUE));
+    // Palette indices past the end, and a delta skip that runs off the end after setting LED 0
+    packet(41, 3, VIALRGB_STREAM_PALETTE, RGB_MATRIX_LED_COUNT - 1, 48, {0x00, 0x00});
+    packet(41, 4, VIALRGB_STREAM_DELTA | VIALRGB_STREAM_LAST, 0, 2, {0, WHITE & 0xFF, WHITE >> 8, 200, BLUE & 0xFF, BLUE >> 8});
+    EXPECT_EQ(status().last_seq, 41);
+
+    render_frame();
+    for (uint8_t led = 0; led < RGB_MATRIX_LED_COUNT; led++) {
+        uint16_t expected = led == 0 ? WHITE : led == RGB_MATRIX_LED_COUNT - 1 ? 0 : led == RGB_MATRIX_LED_COUNT - 2 ? GREEN : RED;
+        expect_flushed(led, expected);
+    }
+}